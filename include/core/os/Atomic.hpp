@@ -0,0 +1,260 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/common.hpp>
+#include <core/os/common.hpp>
+
+#include <core/os/impl/Atomic_.hpp>
+
+NAMESPACE_CORE_OS_BEGIN
+
+/*! \brief Atomic variable
+ *
+ * Shared counters and flags without a system lock.
+ * Loads and stores are plain memory accesses; read-modify-write operations use exclusive load/store on Cortex-M3 and above,
+ * and a critical section only on cores without them.
+ * All the operations can be used from any context: threads, ISRs and system lock zones.
+ *
+ * \code{.cpp}
+ * core::os::Atomic<uint32_t> dropped(0);
+ *
+ * // ISR
+ * dropped.fetch_add(1, core::os::MemoryOrder::RELAXED);
+ * \endcode
+ *
+ * \tparam T integral, enum or pointer type, up to the word size
+ */
+template <typename T>
+class Atomic:
+    private core::Uncopyable
+{
+private:
+    Atomic_<T> impl;
+
+public:
+    /*! \brief Reads the value
+     *
+     */
+    T
+    load(
+        MemoryOrder order = MemoryOrder::SEQ_CST //!< [in] memory order
+    ) const;
+
+
+    /*! \brief Writes the value
+     *
+     */
+    void
+    store(
+        T           value, //!< [in] new value
+        MemoryOrder order = MemoryOrder::SEQ_CST //!< [in] memory order
+    );
+
+
+    /*! \brief Writes the value, returning the previous one
+     *
+     */
+    T
+    exchange(
+        T           value, //!< [in] new value
+        MemoryOrder order = MemoryOrder::SEQ_CST //!< [in] memory order
+    );
+
+
+    /*! \brief Writes the value if it is equal to the expected one
+     *
+     * \return Success
+     * \retval false the value was different, \c expected is updated with it
+     */
+    bool
+    compare_exchange(
+        T&          expected, //!< [in,out] expected value
+        T           desired, //!< [in] new value
+        MemoryOrder order = MemoryOrder::SEQ_CST //!< [in] memory order
+    );
+
+
+    /*! \brief Adds to the value, returning the previous one
+     *
+     */
+    T
+    fetch_add(
+        T           operand, //!< [in] operand
+        MemoryOrder order = MemoryOrder::SEQ_CST //!< [in] memory order
+    );
+
+
+    /*! \brief Subtracts from the value, returning the previous one
+     *
+     */
+    T
+    fetch_sub(
+        T           operand, //!< [in] operand
+        MemoryOrder order = MemoryOrder::SEQ_CST //!< [in] memory order
+    );
+
+
+    /*! \brief Bitwise ands the value, returning the previous one
+     *
+     */
+    T
+    fetch_and(
+        T           operand, //!< [in] operand
+        MemoryOrder order = MemoryOrder::SEQ_CST //!< [in] memory order
+    );
+
+
+    /*! \brief Bitwise ors the value, returning the previous one
+     *
+     */
+    T
+    fetch_or(
+        T           operand, //!< [in] operand
+        MemoryOrder order = MemoryOrder::SEQ_CST //!< [in] memory order
+    );
+
+
+    /*! \brief Bitwise xors the value, returning the previous one
+     *
+     */
+    T
+    fetch_xor(
+        T           operand, //!< [in] operand
+        MemoryOrder order = MemoryOrder::SEQ_CST //!< [in] memory order
+    );
+
+
+public:
+    Atomic(
+        T value = T() //!< [in] initial value
+    );
+};
+
+
+/*! \brief Memory fence
+ *
+ */
+inline
+void
+atomic_fence(
+    MemoryOrder order = MemoryOrder::SEQ_CST //!< [in] memory order
+)
+{
+    AtomicOrder_::fence(order);
+}
+
+template <typename T>
+inline
+T
+Atomic<T>::load(
+    MemoryOrder order
+) const
+{
+    return impl.load(order);
+}
+
+template <typename T>
+inline
+void
+Atomic<T>::store(
+    T           value,
+    MemoryOrder order
+)
+{
+    impl.store(value, order);
+}
+
+template <typename T>
+inline
+T
+Atomic<T>::exchange(
+    T           value,
+    MemoryOrder order
+)
+{
+    return impl.exchange(value, order);
+}
+
+template <typename T>
+inline
+bool
+Atomic<T>::compare_exchange(
+    T&          expected,
+    T           desired,
+    MemoryOrder order
+)
+{
+    return impl.compare_exchange(expected, desired, order);
+}
+
+template <typename T>
+inline
+T
+Atomic<T>::fetch_add(
+    T           operand,
+    MemoryOrder order
+)
+{
+    return impl.fetch_add(operand, order);
+}
+
+template <typename T>
+inline
+T
+Atomic<T>::fetch_sub(
+    T           operand,
+    MemoryOrder order
+)
+{
+    return impl.fetch_sub(operand, order);
+}
+
+template <typename T>
+inline
+T
+Atomic<T>::fetch_and(
+    T           operand,
+    MemoryOrder order
+)
+{
+    return impl.fetch_and(operand, order);
+}
+
+template <typename T>
+inline
+T
+Atomic<T>::fetch_or(
+    T           operand,
+    MemoryOrder order
+)
+{
+    return impl.fetch_or(operand, order);
+}
+
+template <typename T>
+inline
+T
+Atomic<T>::fetch_xor(
+    T           operand,
+    MemoryOrder order
+)
+{
+    return impl.fetch_xor(operand, order);
+}
+
+template <typename T>
+inline
+Atomic<T>::Atomic(
+    T value
+)
+    :
+    impl(value)
+{}
+
+
+NAMESPACE_CORE_OS_END
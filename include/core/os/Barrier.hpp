@@ -0,0 +1,179 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/common.hpp>
+#include <core/os/common.hpp>
+
+#include <core/os/SysLock.hpp>
+#include <core/os/Semaphore.hpp>
+
+NAMESPACE_CORE_OS_BEGIN
+
+/*! \brief Barrier completion that does nothing
+ *
+ */
+struct NoCompletion {
+    void
+    operator()() const {}
+};
+
+/*! \brief Reusable thread barrier
+ *
+ * Blocks the participating threads until all of them have arrived, then starts a new phase.
+ * The last thread to arrive runs the completion, outside the system lock, and then wakes up all the others at once.
+ *
+ * \code{.cpp}
+ * core::os::Barrier<> frame(WORKERS);
+ *
+ * // Each worker
+ * while (true) {
+ *   process_stage();
+ *   frame.arrive_and_wait();
+ * }
+ * \endcode
+ *
+ * \tparam Completion callable with no arguments, run once per phase
+ */
+template <typename Completion = NoCompletion>
+class Barrier:
+    private core::Uncopyable
+{
+public:
+    typedef Semaphore::Count Count;
+
+public:
+    /*! \brief Arrives at the barrier and waits for the others
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    void
+    arrive_and_wait();
+
+
+    /*! \brief Arrives at the barrier and leaves it
+     *
+     * The calling thread does not wait, and is no longer expected in the following phases.
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    void
+    arrive_and_drop();
+
+
+    /*! \brief Gets the number of threads expected in each phase
+     *
+     */
+    Count
+    get_expected() const;
+
+
+    /*! \brief Gets the number of threads still to arrive in the current phase
+     *
+     */
+    Count
+    get_pending() const;
+
+
+public:
+    Barrier(
+        Count      expected, //!< [in] number of participating threads
+        Completion completion = Completion() //!< [in] run by the last arriver of each phase
+    );
+
+private:
+    void
+    complete();
+
+private:
+    Count      _expected;
+    Count      _pending;
+    Semaphore  _waiters;
+    Completion _completion;
+};
+
+
+template <typename Completion>
+inline
+void
+Barrier<Completion>::arrive_and_wait()
+{
+    SysLock::acquire();
+
+    CORE_ASSERT(_pending > 0);
+
+    if (--_pending > 0) {
+        _waiters.wait_unsafe();
+        SysLock::release();
+    } else {
+        _pending = _expected;
+        SysLock::release();
+        complete();
+    }
+}
+
+template <typename Completion>
+inline
+void
+Barrier<Completion>::arrive_and_drop()
+{
+    SysLock::acquire();
+
+    CORE_ASSERT(_pending > 0);
+
+    _expected--;
+
+    if (--_pending > 0) {
+        SysLock::release();
+    } else {
+        _pending = _expected;
+        SysLock::release();
+        complete();
+    }
+}
+
+template <typename Completion>
+inline
+typename Barrier<Completion>::Count
+Barrier<Completion>::get_expected() const
+{
+    return _expected;
+}
+
+template <typename Completion>
+inline
+typename Barrier<Completion>::Count
+Barrier<Completion>::get_pending() const
+{
+    return _pending;
+}
+
+template <typename Completion>
+inline
+void
+Barrier<Completion>::complete()
+{
+    // All the other participants are blocked, nobody can arrive at the next phase before they are released.
+    _completion();
+
+    // Wakes up all the waiters in a single kernel operation.
+    _waiters.reset(0);
+}
+
+template <typename Completion>
+inline
+Barrier<Completion>::Barrier(
+    Count      expected,
+    Completion completion
+)
+    :
+    _expected(expected), _pending(expected), _waiters(static_cast<Count>(0)), _completion(completion)
+{
+    CORE_ASSERT(expected > 0);
+}
+
+NAMESPACE_CORE_OS_END
@@ -0,0 +1,233 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/common.hpp>
+#include <core/os/common.hpp>
+
+#include <core/os/impl/BinarySemaphore_.hpp>
+
+NAMESPACE_CORE_OS_BEGIN
+
+/*! \brief Binary semaphore
+ *
+ * A semaphore whose counter never goes above one: signalling an already signalled semaphore has no effect.
+ * Use it instead of Semaphore for completion flags, where missed signals must not pile up.
+ */
+class BinarySemaphore:
+    private core::Uncopyable
+{
+private:
+    BinarySemaphore_ impl;
+
+public:
+    /*! \brief Initializes the semaphore
+     *
+     * \warning There must be no waiters.
+     */
+    void
+    initialize(
+        bool taken = true //!< [in] initial state, \c true if waits must block
+    );
+
+
+    /*! \brief Resets the semaphore, waking up all the waiters
+     *
+     * \warning Must be used only in a system lock zone (threads and ISRs).
+     */
+    void
+    reset_unsafe(
+        bool taken = true //!< [in] new state
+    );
+
+
+    /*! \brief Signals the semaphore
+     *
+     * \warning Must be used only in a system lock zone (threads and ISRs).
+     */
+    void
+    signal_unsafe();
+
+
+    /*! \brief Waits on the semaphore
+     *
+     * \warning Must be used only in a system lock zone by threads only.
+     */
+    void
+    wait_unsafe();
+
+
+    /*! \brief Waits on the semaphore, within a timeout
+     *
+     * \return \c true if the semaphore has been taken before \c timeout expired
+     *
+     * \warning Must be used only in a system lock zone by threads only.
+     */
+    bool
+    wait_unsafe(
+        const Time& timeout //!< [in] timeout
+    );
+
+
+    /*! \brief Checks if a wait would block
+     *
+     * \warning Must be used only in a system lock zone (threads and ISRs).
+     */
+    bool
+    is_taken_unsafe();
+
+
+    /*! \brief Resets the semaphore, waking up all the waiters
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    void
+    reset(
+        bool taken = true //!< [in] new state
+    );
+
+
+    /*! \brief Signals the semaphore
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    void
+    signal();
+
+
+    /*! \brief Waits on the semaphore
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    void
+    wait();
+
+
+    /*! \brief Waits on the semaphore, within a timeout
+     *
+     * \return \c true if the semaphore has been taken before \c timeout expired
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    bool
+    wait(
+        const Time& timeout //!< [in] timeout
+    );
+
+
+    /*! \brief Checks if a wait would block
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    bool
+    is_taken();
+
+
+public:
+    BinarySemaphore(
+        bool taken = true //!< [in] initial state, \c true if waits must block
+    );
+};
+
+
+inline
+void
+BinarySemaphore::initialize(
+    bool taken
+)
+{
+    impl.initialize(taken);
+}
+
+inline
+void
+BinarySemaphore::reset_unsafe(
+    bool taken
+)
+{
+    impl.reset_unsafe(taken);
+}
+
+inline
+void
+BinarySemaphore::signal_unsafe()
+{
+    impl.signal_unsafe();
+}
+
+inline
+void
+BinarySemaphore::wait_unsafe()
+{
+    impl.wait_unsafe();
+}
+
+inline
+bool
+BinarySemaphore::wait_unsafe(
+    const Time& timeout
+)
+{
+    return impl.wait_unsafe(timeout);
+}
+
+inline
+bool
+BinarySemaphore::is_taken_unsafe()
+{
+    return impl.is_taken_unsafe();
+}
+
+inline
+void
+BinarySemaphore::reset(
+    bool taken
+)
+{
+    impl.reset(taken);
+}
+
+inline
+void
+BinarySemaphore::signal()
+{
+    impl.signal();
+}
+
+inline
+void
+BinarySemaphore::wait()
+{
+    impl.wait();
+}
+
+inline
+bool
+BinarySemaphore::wait(
+    const Time& timeout
+)
+{
+    return impl.wait(timeout);
+}
+
+inline
+bool
+BinarySemaphore::is_taken()
+{
+    return impl.is_taken();
+}
+
+inline
+BinarySemaphore::BinarySemaphore(
+    bool taken
+)
+    :
+    impl(taken)
+{}
+
+
+NAMESPACE_CORE_OS_END
@@ -17,6 +17,10 @@ NAMESPACE_CORE_OS_BEGIN
 #endif
 
 /*! \brief A pretty stupid block allocator.
+ *
+ * Blocks are carved from the storage and never given back to it: freed blocks are kept in a free list per size class,
+ * and reused by the next allocation of the same class. Sizes are rounded up to their class, at most by 25%
+ * (4 bytes granularity up to 28 bytes, then 4 classes per power of two), so alloc and free take constant time.
  *
  * \warning This is WIP - and so it is subject to changes
  */
@@ -35,6 +39,11 @@ public:
     BlockAllocator() : _size(0), _free(0), _root(nullptr), _storage(nullptr)
     {
         _lock.initialize();
+
+        for (unsigned bin = 0; bin < BINS; bin++) {
+            _bins[bin] = nullptr;
+        }
+
 #if CORE_BLOCK_ALLOCATOR_STATS
         _blocks = 0;
         _used   = 0;
@@ -54,6 +63,11 @@ public:
 
         _size = size;
         _free = size;
+        _root = nullptr;
+
+        for (unsigned bin = 0; bin < BINS; bin++) {
+            _bins[bin] = nullptr;
+        }
 
 #if CORE_BLOCK_ALLOCATOR_STATS
         _blocks = 0;
@@ -71,31 +85,37 @@ public:
     {
         CORE_ASSERT(refcount > 0);
 
+        if (size > MAX_SIZE) {
+            return nullptr;
+        }
+
+        std::size_t rounded;
+        unsigned    bin = binOf(size, rounded);
+
         lock<CTX>();
 
-        Item* item = _root;
+        Item* item = _bins[bin];
 
-        while (item != nullptr) {
-            if ((item->flags == 0) && (item->size == size)) {
-                item->flags    = 1;
-                item->refcount = refcount;
+        if (item != nullptr) {
+            _bins[bin]     = item->binNext;
+            item->binNext  = nullptr;
+            item->flags    = 1;
+            item->refcount = refcount;
 #if CORE_BLOCK_ALLOCATOR_STATS
-                _used++;
+            _used++;
 #endif
-                unlock<CTX>();
-                return item->data;
-            }
-
-            item = item->next;
+            unlock<CTX>();
+            return item->data;
         }
 
-        item = (Item*)getBlock(size);
+        item = (Item*)getBlock(rounded);
 
         if (item != nullptr) {
-            item->size     = size;
+            item->size     = static_cast<uint16_t>(rounded);
             item->refcount = refcount;
             item->flags    = 1;
             item->next     = _root;
+            item->binNext  = nullptr;
             item->data     = reinterpret_cast<void*>((uint8_t*)item + sizeof(Item));
             _root = item;
 #if CORE_BLOCK_ALLOCATOR_STATS
@@ -118,8 +138,8 @@ public:
         Item* item = _root;
 
         while (item != nullptr) {
-            if (item->refcount == 0) {
-                item->flags = 0;
+            if ((item->refcount == 0) && (item->flags == 1)) {
+                recycle(item);
 #if CORE_BLOCK_ALLOCATOR_STATS
                 _used--;
 #endif
@@ -171,7 +191,7 @@ public:
                 item->refcount--;
 
                 if (item->refcount == 0) {
-                    item->flags = 0;
+                    recycle(item);
 #if CORE_BLOCK_ALLOCATOR_STATS
                     _used--;
 #endif
@@ -199,7 +219,7 @@ public:
         if (data != nullptr) {
             while (item != nullptr) {
                 if ((item->data == data) && (item->refcount == 0) && (item->flags == 1)) {
-                    item->flags = 0;
+                    recycle(item);
 #if CORE_BLOCK_ALLOCATOR_STATS
                     _used--;
 #endif
@@ -220,10 +240,60 @@ private:
         uint16_t size;
         int8_t   refcount;
         uint8_t  flags;
-        Item*    next;
+        Item*    next; // all the blocks
+        Item*    binNext; // free blocks of the same class
         void*    data;
     } CORE_PACKED; // Aligned by design
 
+    enum : std::size_t {
+        GRANULE        = 4, // bytes
+        LINEAR_CLASSES = 8, // one class per granule count below this, then 4 classes per power of two
+        BINS           = 52,
+        MAX_SIZE       = 57344 // largest class that fits Item::size
+    };
+
+    static unsigned
+    binOf(
+        std::size_t  size,
+        std::size_t& rounded
+    )
+    {
+        uint32_t granules = static_cast<uint32_t>((size + GRANULE - 1) / GRANULE);
+
+        if (granules < LINEAR_CLASSES) {
+            rounded = granules * GRANULE;
+            return granules;
+        }
+
+        // Round up to a multiple of a quarter of the power of two below, then index by power and quarter.
+        unsigned msb  = 31 - __builtin_clz(granules);
+        uint32_t step = static_cast<uint32_t>(1) << (msb - 2);
+
+        granules = (granules + step - 1) & ~(step - 1);
+        msb      = 31 - __builtin_clz(granules);
+        rounded  = granules * GRANULE;
+
+        unsigned bin = LINEAR_CLASSES + (msb - 3) * 4 + ((granules >> (msb - 2)) & 3);
+
+        CORE_ASSERT(bin < BINS);
+        return bin;
+    } // binOf
+
+    void
+    recycle(
+        Item* item
+    )
+    {
+        std::size_t rounded;
+        unsigned    bin = binOf(item->size, rounded);
+
+        CORE_ASSERT(rounded == item->size);
+
+        item->flags   = 0;
+        item->binNext = _bins[bin];
+        _bins[bin]    = item;
+    }
+
     void*
     getBlock(
         std::size_t size
@@ -251,6 +321,7 @@ private:
     std::size_t     _size;
     std::size_t     _free;
     Item*           _root;
+    Item*           _bins[BINS];
     uint8_t*        _storage;
     core::os::Mutex _lock;
 #if CORE_BLOCK_ALLOCATOR_STATS
@@ -268,32 +339,18 @@ private:
     unlock();
 };
 
-template <>
-inline void
-BlockAllocator::lock<core::os::CallingContext::NORMAL>()
-{
-    _lock.acquire();
-}
-
-template <>
-inline void
-BlockAllocator::lock<core::os::CallingContext::SYSLOCK>()
-{
-    _lock.acquire_unsafe();
-}
-
-template <>
+template <core::os::CallingContext CTX>
 inline void
-BlockAllocator::unlock<core::os::CallingContext::NORMAL>()
+BlockAllocator::lock()
 {
-    _lock.release();
+    _lock.acquire<CTX>();
 }
 
-template <>
+template <core::os::CallingContext CTX>
 inline void
-BlockAllocator::unlock<core::os::CallingContext::SYSLOCK>()
+BlockAllocator::unlock()
 {
-    _lock.release_unsafe();
+    _lock.release<CTX>();
 }
 
 NAMESPACE_CORE_OS_END
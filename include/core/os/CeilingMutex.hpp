@@ -0,0 +1,114 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/common.hpp>
+#include <core/os/common.hpp>
+
+#include <core/os/Thread.hpp>
+
+#include <core/os/impl/CeilingMutex_.hpp>
+
+NAMESPACE_CORE_OS_BEGIN
+
+/*! \brief Priority ceiling mutex
+ *
+ * The owner runs at the ceiling priority for as long as it holds the mutex,
+ * so no other thread using the mutex can preempt it: a thread is blocked at most once, for one critical section,
+ * and there is no priority inheritance chain to walk.
+ *
+ * \warning The ceiling must be at least the priority of every thread using the mutex,
+ *          and the owner must not block while holding it.
+ *          Mutexes must be released in the reverse order of acquisition.
+ */
+class CeilingMutex:
+    private core::Uncopyable
+{
+private:
+    CeilingMutex_ impl;
+
+public:
+    /*! \brief Gets the ceiling priority
+     *
+     */
+    Thread::Priority
+    get_ceiling() const;
+
+
+    /*! \brief Raises the calling thread to the ceiling and takes the mutex
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    void
+    acquire();
+
+
+    /*! \brief Takes the mutex if it is free
+     *
+     * \return Success
+     * \retval false the mutex is owned, the priority of the calling thread is unchanged
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    bool
+    try_acquire();
+
+
+    /*! \brief Releases the mutex and restores the priority the owner had before acquiring it
+     *
+     * \warning Must be used only outside a system lock zone, by the owner.
+     */
+    void
+    release();
+
+
+public:
+    explicit
+    CeilingMutex(
+        Thread::Priority ceiling //!< [in] highest priority among the threads using the mutex
+    );
+};
+
+
+inline
+Thread::Priority
+CeilingMutex::get_ceiling() const
+{
+    return impl.get_ceiling();
+}
+
+inline
+void
+CeilingMutex::acquire()
+{
+    impl.acquire();
+}
+
+inline
+bool
+CeilingMutex::try_acquire()
+{
+    return impl.try_acquire();
+}
+
+inline
+void
+CeilingMutex::release()
+{
+    impl.release();
+}
+
+inline
+CeilingMutex::CeilingMutex(
+    Thread::Priority ceiling
+)
+    :
+    impl(ceiling)
+{}
+
+
+NAMESPACE_CORE_OS_END
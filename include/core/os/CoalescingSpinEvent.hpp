@@ -0,0 +1,259 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/common.hpp>
+#include <core/os/common.hpp>
+
+#include <core/os/Time.hpp>
+#include <core/os/Thread.hpp>
+
+#include <core/os/impl/CoalescingSpinEvent_.hpp>
+
+NAMESPACE_CORE_OS_BEGIN
+
+/*! \brief Thread event with coalesced signalling
+ *
+ * Same as SpinEvent, but signals are accumulated and delivered to the thread as a single wakeup,
+ * either when \c threshold signals have been collected or when \c window has elapsed since the first one of a burst.
+ * This bounds the added latency to \c window while a high rate ISR causes far fewer context switches.
+ */
+class CoalescingSpinEvent:
+    private core::Uncopyable
+{
+public:
+    typedef CoalescingSpinEvent_::Mask Mask;
+
+private:
+    CoalescingSpinEvent_ impl;
+
+public:
+    Thread*
+    get_thread() const;
+
+    void
+    set_thread(
+        Thread* threadp
+    );
+
+
+    /*! \brief Sets the maximum delay of a coalesced delivery
+     *
+     * \warning Must be used only outside a system lock zone, with no signals pending.
+     */
+    void
+    set_window(
+        const Time& window //!< [in] delay, at least one system tick
+    );
+
+
+    /*! \brief Sets the number of signals that triggers an immediate delivery
+     *
+     * \warning Must be used only outside a system lock zone, with no signals pending.
+     */
+    void
+    set_threshold(
+        uint32_t threshold //!< [in] number of signals, 1 disables coalescing
+    );
+
+
+    /*! \brief Accumulates a signal
+     *
+     * \warning Must be used only in a system lock zone (threads and ISRs).
+     */
+    void
+    signal_unsafe(
+        unsigned event_index //!< [in] event bit
+    );
+
+
+    /*! \brief Accumulates a signal
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    void
+    signal(
+        unsigned event_index //!< [in] event bit
+    );
+
+
+    /*! \brief Delivers the accumulated signals now
+     *
+     * \warning Must be used only in a system lock zone (threads and ISRs).
+     */
+    void
+    flush_unsafe();
+
+
+    /*! \brief Delivers the accumulated signals now
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    void
+    flush();
+
+
+    /*! \brief Waits for the events of the calling thread
+     *
+     * \return mask of the received events
+     * \retval 0 timeout
+     */
+    Mask
+    wait(
+        const Time& timeout //!< [in] timeout
+    );
+
+
+    /*! \brief Number of signals that did not cause a wakeup of their own
+     *
+     */
+    uint32_t
+    get_coalesced() const;
+
+
+    /*! \brief Number of wakeups delivered
+     *
+     */
+    uint32_t
+    get_delivered() const;
+
+
+    /*! \brief Clears the counters
+     *
+     */
+    void
+    reset_stats();
+
+
+public:
+    CoalescingSpinEvent(
+        const Time& window, //!< [in] maximum delay of a coalesced delivery, at least one system tick
+        uint32_t    threshold, //!< [in] number of signals that triggers an immediate delivery
+        Thread*     threadp = & Thread::self() //!< [in] thread to be signalled
+    );
+
+
+    /*! \brief Disarms the coalescing window, dropping the pending signals
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    ~CoalescingSpinEvent();
+};
+
+
+inline
+Thread*
+CoalescingSpinEvent::get_thread() const
+{
+    return impl.get_thread();
+}
+
+inline
+void
+CoalescingSpinEvent::set_thread(
+    Thread* threadp
+)
+{
+    impl.set_thread(threadp);
+}
+
+inline
+void
+CoalescingSpinEvent::set_window(
+    const Time& window
+)
+{
+    impl.set_window(window);
+}
+
+inline
+void
+CoalescingSpinEvent::set_threshold(
+    uint32_t threshold
+)
+{
+    impl.set_threshold(threshold);
+}
+
+inline
+void
+CoalescingSpinEvent::signal_unsafe(
+    unsigned event_index
+)
+{
+    impl.signal_unsafe(event_index);
+}
+
+inline
+void
+CoalescingSpinEvent::signal(
+    unsigned event_index
+)
+{
+    impl.signal(event_index);
+}
+
+inline
+void
+CoalescingSpinEvent::flush_unsafe()
+{
+    impl.flush_unsafe();
+}
+
+inline
+void
+CoalescingSpinEvent::flush()
+{
+    impl.flush();
+}
+
+inline
+CoalescingSpinEvent::Mask
+CoalescingSpinEvent::wait(
+    const Time& timeout
+)
+{
+    return impl.wait(timeout);
+}
+
+inline
+uint32_t
+CoalescingSpinEvent::get_coalesced() const
+{
+    return impl.get_coalesced();
+}
+
+inline
+uint32_t
+CoalescingSpinEvent::get_delivered() const
+{
+    return impl.get_delivered();
+}
+
+inline
+void
+CoalescingSpinEvent::reset_stats()
+{
+    impl.reset_stats();
+}
+
+inline
+CoalescingSpinEvent::CoalescingSpinEvent(
+    const Time& window,
+    uint32_t    threshold,
+    Thread*     threadp
+)
+    :
+    impl(window, threshold, threadp)
+{}
+
+inline
+CoalescingSpinEvent::~CoalescingSpinEvent()
+{}
+
+
+NAMESPACE_CORE_OS_END
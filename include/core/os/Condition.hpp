@@ -9,11 +9,17 @@
 #include <core/common.hpp>
 #include <core/os/common.hpp>
 
+#include <core/os/SysLock.hpp>
+
 #include <core/os/impl/Condition_.hpp>
 
 NAMESPACE_CORE_OS_BEGIN
 
-
+/*! \brief Condition variable
+ *
+ * Waiters without a timeout can be moved to the queue of the associated Mutex by Condition::broadcast_requeue:
+ * they are then woken up one at a time, as the mutex is released, instead of all contending for it at once.
+ */
 class Condition:
     private core::Uncopyable
 {
@@ -30,6 +36,30 @@ public:
     void
     broadcast_unsafe();
 
+
+    /*! \brief Moves all the waiters to the queue of the mutex held by the calling thread
+     *
+     * Same as Condition::broadcast, but each waiter runs only when it gets the mutex.
+     * Waiters with a timeout are woken up as with Condition::broadcast.
+     *
+     * \pre The calling thread holds the mutex used by the waiters, and it is the last mutex it acquired.
+     *
+     * \warning Must be used only in a system lock zone by threads only.
+     */
+    void
+    broadcast_requeue_unsafe();
+
+
+    /*! \brief Wakes up to \c count waiters, highest priority first
+     *
+     * \warning Must be used only in a system lock zone (threads and ISRs).
+     */
+    void
+    notify_n_unsafe(
+        unsigned count //!< [in] maximum number of waiters to wake up
+    );
+
+
     void
     wait_unsafe();
 
@@ -44,6 +74,30 @@ public:
     void
     broadcast();
 
+
+    /*! \brief Moves all the waiters to the queue of the mutex held by the calling thread
+     *
+     * Same as Condition::broadcast, but each waiter runs only when it gets the mutex.
+     * Waiters with a timeout are woken up as with Condition::broadcast.
+     *
+     * \pre The calling thread holds the mutex used by the waiters, and it is the last mutex it acquired.
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    void
+    broadcast_requeue();
+
+
+    /*! \brief Wakes up to \c count waiters, highest priority first
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    void
+    notify_n(
+        unsigned count //!< [in] maximum number of waiters to wake up
+    );
+
+
     void
     wait();
 
@@ -53,6 +107,46 @@ public:
     );
 
 
+    /*! \brief Wakes up the highest priority waiter, with the locking required by \c CTX
+     *
+     * \tparam CTX calling context
+     */
+    template <core::os::CallingContext CTX>
+    void
+    signal();
+
+
+    /*! \brief Wakes up all the waiters, with the locking required by \c CTX
+     *
+     * \tparam CTX calling context
+     */
+    template <core::os::CallingContext CTX>
+    void
+    broadcast();
+
+
+    /*! \brief Waits on the condition, with the locking required by \c CTX
+     *
+     * \tparam CTX calling context, NORMAL or SYSLOCK (threads only)
+     */
+    template <core::os::CallingContext CTX>
+    void
+    wait();
+
+
+    /*! \brief Waits on the condition within a timeout, with the locking required by \c CTX
+     *
+     * \return \c true if signalled before \c timeout expired
+     *
+     * \tparam CTX calling context, NORMAL or SYSLOCK (threads only)
+     */
+    template <core::os::CallingContext CTX>
+    bool
+    wait(
+        const Time& timeout //!< [in] timeout
+    );
+
+
 public:
     Condition();
     explicit
@@ -83,6 +177,22 @@ Condition::broadcast_unsafe()
     impl.broadcast_unsafe();
 }
 
+inline
+void
+Condition::broadcast_requeue_unsafe()
+{
+    impl.broadcast_requeue_unsafe();
+}
+
+inline
+void
+Condition::notify_n_unsafe(
+    unsigned count
+)
+{
+    impl.notify_n_unsafe(count);
+}
+
 inline
 void
 Condition::wait_unsafe()
@@ -113,6 +223,22 @@ Condition::broadcast()
     impl.broadcast();
 }
 
+inline
+void
+Condition::broadcast_requeue()
+{
+    impl.broadcast_requeue();
+}
+
+inline
+void
+Condition::notify_n(
+    unsigned count
+)
+{
+    impl.notify_n(count);
+}
+
 inline
 void
 Condition::wait()
@@ -129,6 +255,66 @@ Condition::wait(
     return impl.wait(timeout);
 }
 
+template <core::os::CallingContext CTX>
+inline
+void
+Condition::signal()
+{
+    if (CTX == core::os::CallingContext::NORMAL) {
+        signal();
+    } else {
+        SysLock::ScopeFrom<CTX> lock;
+        (void)lock;
+
+        signal_unsafe();
+    }
+}
+
+template <core::os::CallingContext CTX>
+inline
+void
+Condition::broadcast()
+{
+    if (CTX == core::os::CallingContext::NORMAL) {
+        broadcast();
+    } else {
+        SysLock::ScopeFrom<CTX> lock;
+        (void)lock;
+
+        broadcast_unsafe();
+    }
+}
+
+template <core::os::CallingContext CTX>
+inline
+void
+Condition::wait()
+{
+    static_assert(CTX != core::os::CallingContext::ISR, "Cannot wait on a condition from an ISR");
+
+    if (CTX == core::os::CallingContext::NORMAL) {
+        wait();
+    } else {
+        wait_unsafe();
+    }
+}
+
+template <core::os::CallingContext CTX>
+inline
+bool
+Condition::wait(
+    const Time& timeout
+)
+{
+    static_assert(CTX != core::os::CallingContext::ISR, "Cannot wait on a condition from an ISR");
+
+    if (CTX == core::os::CallingContext::NORMAL) {
+        return wait(timeout);
+    } else {
+        return wait_unsafe(timeout);
+    }
+}
+
 inline
 Condition::Condition()
     :
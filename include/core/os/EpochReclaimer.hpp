@@ -0,0 +1,401 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/common.hpp>
+#include <core/os/common.hpp>
+
+#include <core/os/SysLock.hpp>
+#include <core/os/MemoryPool.hpp>
+#include <core/os/BlockAllocator.hpp>
+#include <core/os/Atomic.hpp>
+
+NAMESPACE_CORE_OS_BEGIN
+
+/*! \brief Deferred release of memory read by lock-free readers
+ *
+ * Epoch based reclamation: a reader announces the current epoch in its own slot while it traverses a shared structure.
+ * A writer unlinks a node, then retires it: the node is stamped with the current epoch, and the epoch moves on.
+ * The node goes back to its MemoryPool or BlockAllocator only once every active reader announced a later epoch,
+ * that is once no reader can still hold a pointer to it.
+ *
+ * \code{.cpp}
+ * core::os::EpochReclaimer<4, 32> reclaimer;
+ *
+ * // Reader, owning slot 2 (thread or ISR)
+ * {
+ *   core::os::EpochReclaimer<4, 32>::Guard guard(reclaimer, 2);
+ *
+ *   for (Node* node = head.load(core::os::MemoryOrder::ACQUIRE); node != nullptr; node = node->next.load(core::os::MemoryOrder::ACQUIRE)) {
+ *     ...
+ *   }
+ * }
+ *
+ * // Writer
+ * unlink(node);
+ * reclaimer.retire(pool, node);
+ * ...
+ * reclaimer.reclaim();
+ * \endcode
+ *
+ * Reading costs two atomic stores. Retired nodes are released in retirement order,
+ * so a reader stalled inside its section delays everything retired after it entered.
+ *
+ * \tparam READERS number of reader slots, one per concurrent reader
+ * \tparam CAPACITY number of retired nodes waiting to be released
+ */
+template <std::size_t READERS, std::size_t CAPACITY>
+class EpochReclaimer:
+    private core::Uncopyable
+{
+    static_assert(READERS > 0, "EpochReclaimer needs at least a reader slot");
+    static_assert(CAPACITY > 0, "EpochReclaimer needs room for retired nodes");
+
+public:
+    typedef uint32_t Epoch;
+    typedef void (* Deleter)(void* ownerp, void* objp);
+
+    /*! \brief Read-side section, for the lifetime of the object
+     *
+     */
+    class Guard:
+        private core::Uncopyable
+    {
+    public:
+        Guard(
+            EpochReclaimer& reclaimer, //!< [in] reclaimer
+            unsigned        slot //!< [in] slot owned by the reader
+        );
+
+        ~Guard();
+
+    private:
+        EpochReclaimer& _reclaimer;
+        unsigned        _slot;
+    };
+
+public:
+    /*! \brief Enters a read-side section
+     *
+     * Pointers to shared nodes must be loaded only after entering.
+     * Can be used from any context, including ISRs.
+     *
+     * \warning Each concurrent reader must own a distinct slot, and sections do not nest.
+     */
+    void
+    enter(
+        unsigned slot //!< [in] slot owned by the reader
+    );
+
+
+    /*! \brief Leaves a read-side section
+     *
+     * Pointers to shared nodes must not be used after leaving.
+     */
+    void
+    leave(
+        unsigned slot //!< [in] slot owned by the reader
+    );
+
+
+    /*! \brief Retires a node unlinked from the shared structure
+     *
+     * \c deleter is called with \c ownerp and \c objp once no reader can access \c objp anymore.
+     * When no room is left, the nodes that are already safe are released first.
+     *
+     * \return Success
+     * \retval false no room left, the node has not been retired
+     *
+     * \warning Must be used only by threads, outside a system lock zone.
+     */
+    bool
+    retire(
+        void*   objp, //!< [in] unlinked node
+        Deleter deleter, //!< [in] function releasing the node
+        void*   ownerp //!< [in] first argument of \c deleter
+    );
+
+
+    /*! \brief Retires a node allocated from a MemoryPool
+     *
+     * \see retire
+     */
+    template <typename Item>
+    bool
+    retire(
+        MemoryPool<Item>& pool, //!< [in] pool \c objp was allocated from
+        Item*             objp //!< [in] unlinked node
+    );
+
+
+    /*! \brief Retires a block allocated from a BlockAllocator
+     *
+     * The block is released with BlockAllocator::free, dropping one reference.
+     *
+     * \see retire
+     */
+    bool
+    retire(
+        BlockAllocator& allocator, //!< [in] allocator \c data was allocated from
+        void*           data //!< [in] unlinked block
+    );
+
+
+    /*! \brief Releases the retired nodes no reader can access anymore
+     *
+     * \return number of nodes released
+     *
+     * \warning Must be used only by threads, outside a system lock zone.
+     */
+    std::size_t
+    reclaim();
+
+
+    /*! \brief Number of retired nodes waiting to be released
+     *
+     */
+    std::size_t
+    get_pending() const;
+
+
+public:
+    EpochReclaimer();
+
+private:
+    struct Retired {
+        void*   objp;
+        Deleter deleter;
+        void*   ownerp;
+        Epoch   epoch;
+    };
+
+private:
+    bool
+    is_safe(
+        Epoch epoch
+    ) const;
+
+    template <typename Item>
+    static void
+    pool_deleter(
+        void* ownerp,
+        void* objp
+    );
+
+    static void
+    allocator_deleter(
+        void* ownerp,
+        void* objp
+    );
+
+private:
+    Atomic<Epoch> _epoch; // odd, so that 0 always means quiescent
+    Atomic<Epoch> _slots[READERS]; // epoch announced by each reader, 0 if outside a section
+    Retired       _retired[CAPACITY]; // ring, in retirement (and epoch) order
+    std::size_t   _head;
+    std::size_t   _count;
+};
+
+
+template <std::size_t READERS, std::size_t CAPACITY>
+inline
+EpochReclaimer<READERS, CAPACITY>::Guard::Guard(
+    EpochReclaimer& reclaimer,
+    unsigned        slot
+)
+    :
+    _reclaimer(reclaimer), _slot(slot)
+{
+    _reclaimer.enter(_slot);
+}
+
+template <std::size_t READERS, std::size_t CAPACITY>
+inline
+EpochReclaimer<READERS, CAPACITY>::Guard::~Guard()
+{
+    _reclaimer.leave(_slot);
+}
+
+template <std::size_t READERS, std::size_t CAPACITY>
+inline
+void
+EpochReclaimer<READERS, CAPACITY>::enter(
+    unsigned slot
+)
+{
+    CORE_ASSERT(slot < READERS);
+    CORE_ASSERT(_slots[slot].load(MemoryOrder::RELAXED) == 0);
+
+    // Sequentially consistent: either reclaim sees the slot, or the reader sees the structure without the retired node.
+    _slots[slot].store(_epoch.load(MemoryOrder::SEQ_CST), MemoryOrder::SEQ_CST);
+}
+
+template <std::size_t READERS, std::size_t CAPACITY>
+inline
+void
+EpochReclaimer<READERS, CAPACITY>::leave(
+    unsigned slot
+)
+{
+    CORE_ASSERT(slot < READERS);
+
+    _slots[slot].store(0, MemoryOrder::RELEASE);
+}
+
+template <std::size_t READERS, std::size_t CAPACITY>
+inline
+bool
+EpochReclaimer<READERS, CAPACITY>::retire(
+    void*   objp,
+    Deleter deleter,
+    void*   ownerp
+)
+{
+    CORE_ASSERT(objp != nullptr);
+    CORE_ASSERT(deleter != nullptr);
+
+    for (unsigned attempt = 0; attempt < 2; attempt++) {
+        {
+            SysLock::Scope lock;
+
+            if (_count < CAPACITY) {
+                Retired& retired = _retired[(_head + _count) % CAPACITY];
+
+                retired.objp    = objp;
+                retired.deleter = deleter;
+                retired.ownerp  = ownerp;
+                // Readers entering from now on cannot reach the node, as it has already been unlinked.
+                retired.epoch = _epoch.fetch_add(2, MemoryOrder::SEQ_CST);
+                _count++;
+
+                return true;
+            }
+        }
+
+        if ((attempt == 0) && (reclaim() == 0)) {
+            break;
+        }
+    }
+
+    return false;
+} // retire
+
+template <std::size_t READERS, std::size_t CAPACITY>
+template <typename Item>
+inline
+bool
+EpochReclaimer<READERS, CAPACITY>::retire(
+    MemoryPool<Item>& pool,
+    Item*             objp
+)
+{
+    return retire(objp, &EpochReclaimer::template pool_deleter<Item>, &pool);
+}
+
+template <std::size_t READERS, std::size_t CAPACITY>
+inline
+bool
+EpochReclaimer<READERS, CAPACITY>::retire(
+    BlockAllocator& allocator,
+    void*           data
+)
+{
+    return retire(data, &EpochReclaimer::allocator_deleter, &allocator);
+}
+
+template <std::size_t READERS, std::size_t CAPACITY>
+inline
+std::size_t
+EpochReclaimer<READERS, CAPACITY>::reclaim()
+{
+    std::size_t released = 0;
+
+    for (;;) {
+        Retired retired;
+
+        {
+            SysLock::Scope lock;
+
+            if ((_count == 0) || !is_safe(_retired[_head].epoch)) {
+                break;
+            }
+
+            retired = _retired[_head];
+            _head   = (_head + 1) % CAPACITY;
+            _count--;
+        }
+
+        // Outside the lock, as BlockAllocator::free takes a mutex.
+        retired.deleter(retired.ownerp, retired.objp);
+        released++;
+    }
+
+    return released;
+} // reclaim
+
+template <std::size_t READERS, std::size_t CAPACITY>
+inline
+std::size_t
+EpochReclaimer<READERS, CAPACITY>::get_pending() const
+{
+    return _count;
+}
+
+template <std::size_t READERS, std::size_t CAPACITY>
+inline
+bool
+EpochReclaimer<READERS, CAPACITY>::is_safe(
+    Epoch epoch
+) const
+{
+    for (std::size_t slot = 0; slot < READERS; slot++) {
+        Epoch announced = _slots[slot].load(MemoryOrder::SEQ_CST);
+
+        // Signed difference, so that the comparison survives the epoch wrapping around.
+        if ((announced != 0) && (static_cast<int32_t>(announced - epoch) <= 0)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template <std::size_t READERS, std::size_t CAPACITY>
+template <typename Item>
+inline
+void
+EpochReclaimer<READERS, CAPACITY>::pool_deleter(
+    void* ownerp,
+    void* objp
+)
+{
+    reinterpret_cast<MemoryPool<Item>*>(ownerp)->free(reinterpret_cast<Item*>(objp));
+}
+
+template <std::size_t READERS, std::size_t CAPACITY>
+inline
+void
+EpochReclaimer<READERS, CAPACITY>::allocator_deleter(
+    void* ownerp,
+    void* objp
+)
+{
+    reinterpret_cast<BlockAllocator*>(ownerp)->free(objp);
+}
+
+template <std::size_t READERS, std::size_t CAPACITY>
+inline
+EpochReclaimer<READERS, CAPACITY>::EpochReclaimer()
+    :
+    _epoch(1), _retired(), _head(0), _count(0)
+{
+    for (std::size_t slot = 0; slot < READERS; slot++) {
+        _slots[slot].store(0, MemoryOrder::RELAXED);
+    }
+}
+
+NAMESPACE_CORE_OS_END
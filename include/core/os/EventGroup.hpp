@@ -0,0 +1,257 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/common.hpp>
+#include <core/os/common.hpp>
+
+#include <core/os/Time.hpp>
+
+#include <core/os/impl/EventGroup_.hpp>
+
+NAMESPACE_CORE_OS_BEGIN
+
+/*! \brief Event group
+ *
+ * A set of event flags shared by any number of threads.
+ * Flags can be set and cleared by threads and ISRs; threads wait for any or all the flags of a mask.
+ * Setting flags wakes up only the waiters whose condition became true, in priority order (FIFO among equal priorities).
+ *
+ * Flags are not cleared when a waiter wakes up, EventGroup::clear must be called explicitly.
+ */
+class EventGroup:
+    private core::Uncopyable
+{
+public:
+    typedef EventGroup_::Mask Mask;
+
+private:
+    EventGroup_ impl;
+
+public:
+    /*! \brief Initialize the group
+     *
+     * \warning There must be no waiters.
+     */
+    void
+    initialize(
+        Mask value = 0 //!< [in] initial flags
+    );
+
+
+    /*! \brief Gets the current flags
+     *
+     */
+    Mask
+    get() const;
+
+
+    /*! \brief Sets flags
+     *
+     * \warning Must be used only in a system lock zone (threads and ISRs).
+     */
+    void
+    set_unsafe(
+        Mask mask //!< [in] flags to set
+    );
+
+
+    /*! \brief Clears flags
+     *
+     * \warning Must be used only in a system lock zone (threads and ISRs).
+     */
+    void
+    clear_unsafe(
+        Mask mask //!< [in] flags to clear
+    );
+
+
+    /*! \brief Waits for any of the flags in a mask
+     *
+     * \return the flags of \c mask that are set
+     * \retval 0 timeout
+     *
+     * \warning Must be used only in a system lock zone by threads only.
+     */
+    Mask
+    wait_any_unsafe(
+        Mask        mask, //!< [in] flags to wait for
+        const Time& timeout = Time::INFINITE //!< [in] timeout
+    );
+
+
+    /*! \brief Waits for all the flags in a mask
+     *
+     * \return \c mask
+     * \retval 0 timeout
+     *
+     * \warning Must be used only in a system lock zone by threads only.
+     */
+    Mask
+    wait_all_unsafe(
+        Mask        mask, //!< [in] flags to wait for
+        const Time& timeout = Time::INFINITE //!< [in] timeout
+    );
+
+
+    /*! \brief Sets flags
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    void
+    set(
+        Mask mask //!< [in] flags to set
+    );
+
+
+    /*! \brief Clears flags
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    void
+    clear(
+        Mask mask //!< [in] flags to clear
+    );
+
+
+    /*! \brief Waits for any of the flags in a mask
+     *
+     * \return the flags of \c mask that are set
+     * \retval 0 timeout
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    Mask
+    wait_any(
+        Mask        mask, //!< [in] flags to wait for
+        const Time& timeout = Time::INFINITE //!< [in] timeout
+    );
+
+
+    /*! \brief Waits for all the flags in a mask
+     *
+     * \return \c mask
+     * \retval 0 timeout
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    Mask
+    wait_all(
+        Mask        mask, //!< [in] flags to wait for
+        const Time& timeout = Time::INFINITE //!< [in] timeout
+    );
+
+
+public:
+    EventGroup(
+        Mask value = 0 //!< [in] initial flags
+    );
+};
+
+
+inline
+void
+EventGroup::initialize(
+    Mask value
+)
+{
+    impl.initialize(value);
+}
+
+inline
+EventGroup::Mask
+EventGroup::get() const
+{
+    return impl.get();
+}
+
+inline
+void
+EventGroup::set_unsafe(
+    Mask mask
+)
+{
+    impl.set_unsafe(mask);
+}
+
+inline
+void
+EventGroup::clear_unsafe(
+    Mask mask
+)
+{
+    impl.clear_unsafe(mask);
+}
+
+inline
+EventGroup::Mask
+EventGroup::wait_any_unsafe(
+    Mask        mask,
+    const Time& timeout
+)
+{
+    return impl.wait_any_unsafe(mask, timeout);
+}
+
+inline
+EventGroup::Mask
+EventGroup::wait_all_unsafe(
+    Mask        mask,
+    const Time& timeout
+)
+{
+    return impl.wait_all_unsafe(mask, timeout);
+}
+
+inline
+void
+EventGroup::set(
+    Mask mask
+)
+{
+    impl.set(mask);
+}
+
+inline
+void
+EventGroup::clear(
+    Mask mask
+)
+{
+    impl.clear(mask);
+}
+
+inline
+EventGroup::Mask
+EventGroup::wait_any(
+    Mask        mask,
+    const Time& timeout
+)
+{
+    return impl.wait_any(mask, timeout);
+}
+
+inline
+EventGroup::Mask
+EventGroup::wait_all(
+    Mask        mask,
+    const Time& timeout
+)
+{
+    return impl.wait_all(mask, timeout);
+}
+
+inline
+EventGroup::EventGroup(
+    Mask value
+)
+    :
+    impl(value)
+{}
+
+
+NAMESPACE_CORE_OS_END
@@ -0,0 +1,158 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/common.hpp>
+#include <core/os/common.hpp>
+
+#include <core/os/EventSource.hpp>
+
+#include <core/os/impl/EventListener_.hpp>
+
+NAMESPACE_CORE_OS_BEGIN
+
+/*! \brief Listener of an EventSource
+ *
+ * Binds the calling thread to an EventSource: each broadcast adds its flags to the listener
+ * and signals the chosen event bit, so the thread waits for it like for a SpinEvent.
+ * The listener detaches itself when destroyed.
+ *
+ * \code{.cpp}
+ * core::os::EventListener listener;
+ *
+ * listener.attach(source, RX_EVENT);
+ *
+ * while (true) {
+ *   core::os::SpinEvent::Mask mask = event.wait(core::os::Time::INFINITE);
+ *
+ *   if (mask & listener.get_mask()) {
+ *     core::os::EventListener::Flags flags = listener.get_and_clear_flags();
+ *     ...
+ *   }
+ * }
+ * \endcode
+ */
+class EventListener:
+    private core::Uncopyable
+{
+public:
+    typedef EventListener_::Flags Flags;
+    typedef EventListener_::Mask  Mask;
+
+private:
+    EventListener_ impl;
+
+public:
+    /*! \brief Attaches the calling thread to a source
+     *
+     * \warning Must be used only outside a system lock zone, by the listening thread.
+     */
+    void
+    attach(
+        EventSource& source, //!< [in] source
+        unsigned     event_index, //!< [in] event bit signalled to the thread
+        Flags        flags = static_cast<Flags>(-1) //!< [in] flags that signal the thread, the others are only accumulated
+    );
+
+
+    /*! \brief Detaches from the source
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    void
+    detach();
+
+
+    /*! \brief Checks if the listener is attached to a source
+     *
+     */
+    bool
+    is_attached() const;
+
+
+    /*! \brief Gets the event mask signalled to the thread
+     *
+     */
+    Mask
+    get_mask() const;
+
+
+    /*! \brief Gets and clears the accumulated flags
+     *
+     * \warning Must be used only in a system lock zone.
+     */
+    Flags
+    get_and_clear_flags_unsafe();
+
+
+    /*! \brief Gets and clears the accumulated flags
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    Flags
+    get_and_clear_flags();
+
+
+public:
+    EventListener();
+};
+
+
+inline
+void
+EventListener::attach(
+    EventSource& source,
+    unsigned     event_index,
+    Flags        flags
+)
+{
+    impl.attach(source.get_impl(), event_index, flags);
+}
+
+inline
+void
+EventListener::detach()
+{
+    impl.detach();
+}
+
+inline
+bool
+EventListener::is_attached() const
+{
+    return impl.is_attached();
+}
+
+inline
+EventListener::Mask
+EventListener::get_mask() const
+{
+    return impl.get_mask();
+}
+
+inline
+EventListener::Flags
+EventListener::get_and_clear_flags_unsafe()
+{
+    return impl.get_and_clear_flags_unsafe();
+}
+
+inline
+EventListener::Flags
+EventListener::get_and_clear_flags()
+{
+    return impl.get_and_clear_flags();
+}
+
+inline
+EventListener::EventListener()
+    :
+    impl()
+{}
+
+
+NAMESPACE_CORE_OS_END
@@ -0,0 +1,109 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/common.hpp>
+#include <core/os/common.hpp>
+
+#include <core/os/impl/EventSource_.hpp>
+
+NAMESPACE_CORE_OS_BEGIN
+
+/*! \brief Event source with any number of listeners
+ *
+ * A broadcast ORs its flags into every attached EventListener and signals the event bit of each listening thread,
+ * all in a single kernel operation.
+ *
+ * \see EventListener
+ */
+class EventSource:
+    private core::Uncopyable
+{
+public:
+    typedef EventSource_::Flags Flags;
+
+private:
+    EventSource_ impl;
+
+public:
+    /*! \brief Initializes the source
+     *
+     * \warning There must be no attached listeners.
+     */
+    void
+    initialize();
+
+
+    /*! \brief Broadcasts flags to all the listeners
+     *
+     * \warning Must be used only in a system lock zone (threads and ISRs).
+     */
+    void
+    broadcast_unsafe(
+        Flags flags = 0 //!< [in] flags to be added to the listeners
+    );
+
+
+    /*! \brief Broadcasts flags to all the listeners
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    void
+    broadcast(
+        Flags flags = 0 //!< [in] flags to be added to the listeners
+    );
+
+
+    EventSource_&
+    get_impl();
+
+
+public:
+    EventSource();
+};
+
+
+inline
+void
+EventSource::initialize()
+{
+    impl.initialize();
+}
+
+inline
+void
+EventSource::broadcast_unsafe(
+    Flags flags
+)
+{
+    impl.broadcast_unsafe(flags);
+}
+
+inline
+void
+EventSource::broadcast(
+    Flags flags
+)
+{
+    impl.broadcast(flags);
+}
+
+inline
+EventSource_&
+EventSource::get_impl()
+{
+    return impl;
+}
+
+inline
+EventSource::EventSource()
+    :
+    impl()
+{}
+
+
+NAMESPACE_CORE_OS_END
@@ -0,0 +1,602 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/common.hpp>
+#include <core/os/common.hpp>
+
+#include <core/os/Time.hpp>
+#include <core/os/SysLock.hpp>
+#include <core/os/MemoryPool.hpp>
+#include <core/os/BinarySemaphore.hpp>
+#include <core/os/Atomic.hpp>
+
+#include <new>
+#include <type_traits>
+
+NAMESPACE_CORE_OS_BEGIN
+
+template <typename T>
+class Promise;
+
+template <typename T>
+class Future;
+
+/*! \brief State shared by a Promise and its Futures
+ *
+ * Allocated from a MemoryPool, and returned to it when the last Promise or Future referring to it is gone.
+ * The value is destroyed in a system lock zone, so \c T should have a trivial destructor.
+ * When the last Promise is gone without setting the value the promise is broken, and the waiters are woken up.
+ */
+template <typename T>
+class FutureState:
+    private core::Uncopyable
+{
+public:
+    typedef MemoryPool<FutureState<T> > Pool;
+    typedef void (* Continuation)(const T& value, void* argp);
+
+private:
+    friend class Promise<T>;
+    friend class Future<T>;
+
+    FutureState(
+        Pool& pool
+    );
+
+    ~FutureState();
+
+    const T&
+    value() const;
+
+    static FutureState*
+    create(
+        Pool& pool
+    );
+
+    static FutureState*
+    retain(
+        FutureState* statep,
+        bool         promise
+    );
+
+    template <core::os::CallingContext CTX = core::os::CallingContext::NORMAL>
+    static void
+    release(
+        FutureState* statep,
+        bool         promise
+    );
+
+private:
+    Pool&             _pool;
+    uint8_t           _references;
+    uint8_t           _promises;
+    Atomic<bool>      _ready;
+    Atomic<bool>      _broken;
+    BinarySemaphore   _done;
+    Continuation      _continuation;
+    void*             _argp;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type _storage;
+};
+
+/*! \brief Producer side of a one-shot asynchronous result
+ *
+ * \code{.cpp}
+ * core::os::Promise<Reply>::Pool replies(storage, REPLIES);
+ *
+ * // Client
+ * core::os::Promise<Reply> promise(replies);
+ * core::os::Future<Reply>  future(promise);
+ *
+ * server.post(Request(..., promise));
+ *
+ * Reply reply;
+ *
+ * if (future.get_for(reply, core::os::Time::ms(10))) {
+ *   ...
+ * }
+ *
+ * // Server, or an ISR with set_value<core::os::CallingContext::ISR>
+ * request.promise.set_value(reply);
+ * \endcode
+ *
+ * Promise and Future are handles: copies refer to the same state.
+ * They must be created, copied and destroyed by threads, outside a system lock zone.
+ * Destroying the last Promise without setting the value breaks the promise: Future::get_for returns \c false,
+ * and Future::is_broken tells it from a timeout.
+ */
+template <typename T>
+class Promise
+{
+public:
+    typedef typename FutureState<T>::Pool Pool;
+
+public:
+    /*! \brief Checks if the promise refers to a state
+     *
+     * \retval false default constructed, pool exhausted, or value already set through this handle
+     */
+    bool
+    is_valid() const;
+
+
+    /*! \brief Sets the value, waking up the waiters and running the continuation
+     *
+     * The continuation runs in the calling context, outside the system lock unless \c CTX is SYSLOCK.
+     * The handle is detached from the state.
+     */
+    template <core::os::CallingContext CTX = core::os::CallingContext::NORMAL>
+    void
+    set_value(
+        const T& value //!< [in] result
+    );
+
+
+public:
+    Promise();
+
+    explicit
+    Promise(
+        Pool& pool //!< [in] pool the state is allocated from
+    );
+
+    Promise(
+        const Promise& other
+    );
+
+    Promise&
+    operator=(
+        const Promise& other
+    );
+
+    ~Promise();
+
+private:
+    friend class Future<T>;
+
+    FutureState<T>* _state;
+};
+
+/*! \brief Consumer side of a one-shot asynchronous result
+ *
+ * \see Promise
+ */
+template <typename T>
+class Future
+{
+public:
+    typedef typename FutureState<T>::Continuation Continuation;
+
+public:
+    /*! \brief Checks if the future refers to a state
+     *
+     */
+    bool
+    is_valid() const;
+
+
+    /*! \brief Checks if the value has been set
+     *
+     * Can be used from any context, including ISRs.
+     */
+    bool
+    is_ready() const;
+
+
+    /*! \brief Checks if all the promises are gone without setting the value
+     *
+     * Can be used from any context, including ISRs.
+     */
+    bool
+    is_broken() const;
+
+
+    /*! \brief Waits for the value
+     *
+     * \return the value, valid while the future exists
+     *
+     * \pre The promise is not broken, use Future::get_for otherwise.
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    const T&
+    get();
+
+
+    /*! \brief Waits for the value, within a timeout
+     *
+     * \return \c true if the value has been set before \c timeout expired
+     * \retval false timeout, or broken promise
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    bool
+    get_for(
+        T&          value, //!< [out] result
+        const Time& timeout //!< [in] timeout
+    );
+
+
+    /*! \brief Sets the function to be called with the value
+     *
+     * If the value is already set \c continuation is called immediately by the calling thread,
+     * otherwise it will be called by Promise::set_value, in its calling context.
+     * It is never called if the promise is broken.
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    void
+    then(
+        Continuation continuation, //!< [in] function to be called
+        void*        argp = nullptr //!< [in] argument passed to \c continuation
+    );
+
+
+public:
+    Future();
+
+    explicit
+    Future(
+        const Promise<T>& promise //!< [in] promise providing the value
+    );
+
+    Future(
+        const Future& other
+    );
+
+    Future&
+    operator=(
+        const Future& other
+    );
+
+    ~Future();
+
+private:
+    FutureState<T>* _state;
+};
+
+
+template <typename T>
+inline
+FutureState<T>::FutureState(
+    Pool& pool
+)
+    :
+    _pool(pool), _references(1), _promises(1), _ready(false), _broken(false), _done(true), _continuation(nullptr), _argp(nullptr)
+{}
+
+template <typename T>
+inline
+FutureState<T>::~FutureState()
+{
+    if (_ready.load(MemoryOrder::RELAXED)) {
+        reinterpret_cast<T*>(&_storage)->~T();
+    }
+}
+
+template <typename T>
+inline
+const T&
+FutureState<T>::value() const
+{
+    return *reinterpret_cast<const T*>(&_storage);
+}
+
+template <typename T>
+inline
+FutureState<T>*
+FutureState<T>::create(
+    Pool& pool
+)
+{
+    FutureState* statep = pool.alloc();
+
+    if (statep != nullptr) {
+        new (statep) FutureState(pool);
+    }
+
+    return statep;
+}
+
+template <typename T>
+inline
+FutureState<T>*
+FutureState<T>::retain(
+    FutureState* statep,
+    bool         promise
+)
+{
+    if (statep != nullptr) {
+        SysLock::Scope lock;
+
+        CORE_ASSERT(statep->_references < 0xFF);
+        statep->_references++;
+
+        if (promise) {
+            statep->_promises++;
+        }
+    }
+
+    return statep;
+}
+
+template <typename T>
+template <core::os::CallingContext CTX>
+inline
+void
+FutureState<T>::release(
+    FutureState* statep,
+    bool         promise
+)
+{
+    if (statep != nullptr) {
+        SysLock::ScopeFrom<CTX> lock;
+        (void)lock;
+
+        CORE_ASSERT(statep->_references > 0);
+
+        if (promise) {
+            CORE_ASSERT(statep->_promises > 0);
+
+            if ((--statep->_promises == 0) && !statep->_ready.load(MemoryOrder::RELAXED)) {
+                // Nobody can set the value anymore: wake up the waiters, they will find the promise broken.
+                statep->_broken.store(true, MemoryOrder::RELEASE);
+                statep->_done.reset_unsafe(false);
+            }
+        }
+
+        if (--statep->_references == 0) {
+            Pool& pool = statep->_pool;
+
+            statep->~FutureState();
+            pool.free_unsafe(statep);
+        }
+    }
+}
+
+template <typename T>
+inline
+bool
+Promise<T>::is_valid() const
+{
+    return _state != nullptr;
+}
+
+template <typename T>
+template <core::os::CallingContext CTX>
+inline
+void
+Promise<T>::set_value(
+    const T& value
+)
+{
+    FutureState<T>* statep = _state;
+    typename FutureState<T>::Continuation continuation;
+
+    CORE_ASSERT(statep != nullptr);
+
+    {
+        SysLock::ScopeFrom<CTX> lock;
+        (void)lock;
+
+        CORE_ASSERT(!statep->_ready.load(MemoryOrder::RELAXED));
+
+        new (&statep->_storage) T(value);
+        statep->_ready.store(true, MemoryOrder::RELEASE);
+
+        // Wakes up all the waiters, and leaves the semaphore signalled for the late ones.
+        statep->_done.reset_unsafe(false);
+
+        continuation = statep->_continuation;
+    }
+
+    // Our reference keeps the value alive while the continuation runs.
+    if (continuation != nullptr) {
+        continuation(statep->value(), statep->_argp);
+    }
+
+    _state = nullptr;
+    FutureState<T>::template release<CTX>(statep, true);
+} // set_value
+
+template <typename T>
+inline
+Promise<T>::Promise()
+    :
+    _state(nullptr)
+{}
+
+template <typename T>
+inline
+Promise<T>::Promise(
+    Pool& pool
+)
+    :
+    _state(FutureState<T>::create(pool))
+{}
+
+template <typename T>
+inline
+Promise<T>::Promise(
+    const Promise& other
+)
+    :
+    _state(FutureState<T>::retain(other._state, true))
+{}
+
+template <typename T>
+inline
+Promise<T>&
+Promise<T>::operator=(
+    const Promise& other
+)
+{
+    if (_state != other._state) {
+        FutureState<T>::release(_state, true);
+        _state = FutureState<T>::retain(other._state, true);
+    }
+
+    return *this;
+}
+
+template <typename T>
+inline
+Promise<T>::~Promise()
+{
+    FutureState<T>::release(_state, true);
+}
+
+template <typename T>
+inline
+bool
+Future<T>::is_valid() const
+{
+    return _state != nullptr;
+}
+
+template <typename T>
+inline
+bool
+Future<T>::is_ready() const
+{
+    return (_state != nullptr) && _state->_ready.load(MemoryOrder::ACQUIRE);
+}
+
+template <typename T>
+inline
+bool
+Future<T>::is_broken() const
+{
+    return (_state != nullptr) && _state->_broken.load(MemoryOrder::ACQUIRE);
+}
+
+template <typename T>
+inline
+const T&
+Future<T>::get()
+{
+    CORE_ASSERT(_state != nullptr);
+
+    {
+        // Checked under the lock: a waiter still seeing nothing is queued before set_value wakes everybody up,
+        // so the semaphore unit is never taken and late waiters cannot block on it.
+        SysLock::Scope lock;
+
+        if (!_state->_ready.load(MemoryOrder::RELAXED) && !_state->_broken.load(MemoryOrder::RELAXED)) {
+            _state->_done.wait_unsafe();
+        }
+    }
+
+    CORE_ASSERT(_state->_ready.load(MemoryOrder::ACQUIRE));
+
+    return _state->value();
+}
+
+template <typename T>
+inline
+bool
+Future<T>::get_for(
+    T&          value,
+    const Time& timeout
+)
+{
+    CORE_ASSERT(_state != nullptr);
+
+    {
+        // The result of the wait does not matter: waiters are woken up by a reset, and the value may be set right after a timeout.
+        SysLock::Scope lock;
+
+        if (!_state->_ready.load(MemoryOrder::RELAXED) && !_state->_broken.load(MemoryOrder::RELAXED)) {
+            _state->_done.wait_unsafe(timeout);
+        }
+    }
+
+    if (!_state->_ready.load(MemoryOrder::ACQUIRE)) {
+        return false;
+    }
+
+    value = _state->value();
+    return true;
+}
+
+template <typename T>
+inline
+void
+Future<T>::then(
+    Continuation continuation,
+    void*        argp
+)
+{
+    bool ready;
+
+    CORE_ASSERT(_state != nullptr);
+    CORE_ASSERT(continuation != nullptr);
+
+    {
+        SysLock::Scope lock;
+
+        ready = _state->_ready.load(MemoryOrder::RELAXED);
+
+        if (!ready) {
+            _state->_continuation = continuation;
+            _state->_argp         = argp;
+        }
+    }
+
+    if (ready) {
+        continuation(_state->value(), argp);
+    }
+}
+
+template <typename T>
+inline
+Future<T>::Future()
+    :
+    _state(nullptr)
+{}
+
+template <typename T>
+inline
+Future<T>::Future(
+    const Promise<T>& promise
+)
+    :
+    _state(FutureState<T>::retain(promise._state, false))
+{}
+
+template <typename T>
+inline
+Future<T>::Future(
+    const Future& other
+)
+    :
+    _state(FutureState<T>::retain(other._state, false))
+{}
+
+template <typename T>
+inline
+Future<T>&
+Future<T>::operator=(
+    const Future& other
+)
+{
+    if (_state != other._state) {
+        FutureState<T>::release(_state, false);
+        _state = FutureState<T>::retain(other._state, false);
+    }
+
+    return *this;
+}
+
+template <typename T>
+inline
+Future<T>::~Future()
+{
+    FutureState<T>::release(_state, false);
+}
+
+NAMESPACE_CORE_OS_END
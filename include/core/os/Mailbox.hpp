@@ -0,0 +1,361 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/common.hpp>
+#include <core/os/common.hpp>
+
+#include <core/os/Time.hpp>
+
+#include <core/os/impl/Mailbox_.hpp>
+
+NAMESPACE_CORE_OS_BEGIN
+
+template <typename T, std::size_t N>
+class Mailbox;
+
+/*! \brief Bounded FIFO of pointers
+ *
+ * Urgent messages posted with post_ahead are fetched before everything already queued.
+ *
+ * \code{.cpp}
+ * core::os::Mailbox<Command*, 16> commands;
+ *
+ * // Clients
+ * commands.post(&bulk);
+ * commands.post_ahead(&stop);
+ *
+ * // Server
+ * Command* commandp;
+ *
+ * if (commands.fetch(commandp, core::os::Time::ms(100))) {
+ *   commandp->execute();
+ * }
+ * \endcode
+ *
+ * \tparam T pointed type
+ * \tparam N capacity, in messages
+ */
+template <typename T, std::size_t N>
+class Mailbox<T*, N>:
+    private core::Uncopyable
+{
+    static_assert(N > 0, "Mailbox cannot be empty");
+    static_assert(sizeof(T*) <= sizeof(Mailbox_::Message), "Pointers do not fit a mailbox message");
+
+public:
+    /*! \brief Posts a message
+     *
+     * \return \c true if posted, \c false if the mailbox is full
+     *
+     * \warning Must be used only in a system lock zone (threads and ISRs).
+     */
+    bool
+    post_unsafe(
+        T* msgp //!< [in] message
+    );
+
+
+    /*! \brief Posts an urgent message, to be fetched first
+     *
+     * \return \c true if posted, \c false if the mailbox is full
+     *
+     * \warning Must be used only in a system lock zone (threads and ISRs).
+     */
+    bool
+    post_ahead_unsafe(
+        T* msgp //!< [in] message
+    );
+
+
+    /*! \brief Fetches a message
+     *
+     * \return \c true if fetched, \c false if the mailbox is empty
+     *
+     * \warning Must be used only in a system lock zone (threads and ISRs).
+     */
+    bool
+    fetch_unsafe(
+        T*& msgp //!< [out] message
+    );
+
+
+    /*! \brief Number of queued messages
+     *
+     * \warning Must be used only in a system lock zone (threads and ISRs).
+     */
+    std::size_t
+    get_used_unsafe();
+
+
+    /*! \brief Number of free slots
+     *
+     * \warning Must be used only in a system lock zone (threads and ISRs).
+     */
+    std::size_t
+    get_free_unsafe();
+
+
+    /*! \brief Posts a message, waiting for a free slot
+     *
+     * \return \c true if posted before \c timeout expired
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    bool
+    post(
+        T*          msgp, //!< [in] message
+        const Time& timeout = Time::INFINITE //!< [in] timeout
+    );
+
+
+    /*! \brief Posts an urgent message, to be fetched first, waiting for a free slot
+     *
+     * \return \c true if posted before \c timeout expired
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    bool
+    post_ahead(
+        T*          msgp, //!< [in] message
+        const Time& timeout = Time::INFINITE //!< [in] timeout
+    );
+
+
+    /*! \brief Fetches a message, waiting for one to be posted
+     *
+     * \return \c true if fetched before \c timeout expired
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    bool
+    fetch(
+        T*&         msgp, //!< [out] message
+        const Time& timeout = Time::INFINITE //!< [in] timeout
+    );
+
+
+    /*! \brief Number of queued messages
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    std::size_t
+    get_used();
+
+
+    /*! \brief Number of free slots
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    std::size_t
+    get_free();
+
+
+    /*! \brief Highest number of queued messages since construction or the last reset_watermark
+     *
+     */
+    std::size_t
+    get_watermark() const;
+
+
+    /*! \brief Restarts the watermark from the current fill level
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    void
+    reset_watermark();
+
+
+    /*! \brief Drops all the messages, waking up the waiting threads
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    void
+    reset();
+
+
+public:
+    Mailbox();
+
+private:
+    static Mailbox_::Message
+    to_message(
+        T* msgp
+    );
+
+    static T*
+    from_message(
+        Mailbox_::Message msg
+    );
+
+private:
+    Mailbox_::Message _buffer[N];
+    Mailbox_ impl;
+};
+
+
+template <typename T, std::size_t N>
+inline
+bool
+Mailbox<T*, N>::post_unsafe(
+    T* msgp
+)
+{
+    return impl.post_unsafe(to_message(msgp));
+}
+
+template <typename T, std::size_t N>
+inline
+bool
+Mailbox<T*, N>::post_ahead_unsafe(
+    T* msgp
+)
+{
+    return impl.post_ahead_unsafe(to_message(msgp));
+}
+
+template <typename T, std::size_t N>
+inline
+bool
+Mailbox<T*, N>::fetch_unsafe(
+    T*& msgp
+)
+{
+    Mailbox_::Message msg;
+
+    if (!impl.fetch_unsafe(msg)) {
+        return false;
+    }
+
+    msgp = from_message(msg);
+    return true;
+}
+
+template <typename T, std::size_t N>
+inline
+std::size_t
+Mailbox<T*, N>::get_used_unsafe()
+{
+    return impl.get_used_unsafe();
+}
+
+template <typename T, std::size_t N>
+inline
+std::size_t
+Mailbox<T*, N>::get_free_unsafe()
+{
+    return impl.get_free_unsafe();
+}
+
+template <typename T, std::size_t N>
+inline
+bool
+Mailbox<T*, N>::post(
+    T*          msgp,
+    const Time& timeout
+)
+{
+    return impl.post(to_message(msgp), timeout);
+}
+
+template <typename T, std::size_t N>
+inline
+bool
+Mailbox<T*, N>::post_ahead(
+    T*          msgp,
+    const Time& timeout
+)
+{
+    return impl.post_ahead(to_message(msgp), timeout);
+}
+
+template <typename T, std::size_t N>
+inline
+bool
+Mailbox<T*, N>::fetch(
+    T*&         msgp,
+    const Time& timeout
+)
+{
+    Mailbox_::Message msg;
+
+    if (!impl.fetch(msg, timeout)) {
+        return false;
+    }
+
+    msgp = from_message(msg);
+    return true;
+}
+
+template <typename T, std::size_t N>
+inline
+std::size_t
+Mailbox<T*, N>::get_used()
+{
+    return impl.get_used();
+}
+
+template <typename T, std::size_t N>
+inline
+std::size_t
+Mailbox<T*, N>::get_free()
+{
+    return impl.get_free();
+}
+
+template <typename T, std::size_t N>
+inline
+std::size_t
+Mailbox<T*, N>::get_watermark() const
+{
+    return impl.get_watermark();
+}
+
+template <typename T, std::size_t N>
+inline
+void
+Mailbox<T*, N>::reset_watermark()
+{
+    impl.reset_watermark();
+}
+
+template <typename T, std::size_t N>
+inline
+void
+Mailbox<T*, N>::reset()
+{
+    impl.reset();
+}
+
+template <typename T, std::size_t N>
+inline
+Mailbox_::Message
+Mailbox<T*, N>::to_message(
+    T* msgp
+)
+{
+    return static_cast<Mailbox_::Message>(reinterpret_cast<uintptr_t>(msgp));
+}
+
+template <typename T, std::size_t N>
+inline
+T*
+Mailbox<T*, N>::from_message(
+    Mailbox_::Message msg
+)
+{
+    return reinterpret_cast<T*>(static_cast<uintptr_t>(msg));
+}
+
+template <typename T, std::size_t N>
+inline
+Mailbox<T*, N>::Mailbox()
+    :
+    _buffer(), impl(_buffer, N)
+{}
+
+NAMESPACE_CORE_OS_END
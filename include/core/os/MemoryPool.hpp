@@ -9,6 +9,8 @@
 #include <core/common.hpp>
 #include <core/os/common.hpp>
 
+#include <core/os/SysLock.hpp>
+
 #include <core/os/impl/MemoryPool_.hpp>
 
 NAMESPACE_CORE_OS_BEGIN
@@ -46,6 +48,27 @@ public:
         Item* objp
     );
 
+
+    /*! \brief Allocates an item, with the locking required by \c CTX
+     *
+     * \tparam CTX calling context
+     */
+    template <core::os::CallingContext CTX>
+    Item*
+    alloc();
+
+
+    /*! \brief Frees an item, with the locking required by \c CTX
+     *
+     * \tparam CTX calling context
+     */
+    template <core::os::CallingContext CTX>
+    void
+    free(
+        Item* objp //!< [in] item to be freed
+    );
+
+
     void
     extend(
         Item   array[],
@@ -127,6 +150,40 @@ MemoryPool<Item>::free(
     impl.free(reinterpret_cast<void*>(objp));
 }
 
+template <typename Item>
+template <core::os::CallingContext CTX>
+inline
+Item*
+MemoryPool<Item>::alloc()
+{
+    if (CTX == core::os::CallingContext::NORMAL) {
+        return alloc();
+    } else {
+        SysLock::ScopeFrom<CTX> lock;
+        (void)lock;
+
+        return alloc_unsafe();
+    }
+}
+
+template <typename Item>
+template <core::os::CallingContext CTX>
+inline
+void
+MemoryPool<Item>::free(
+    Item* objp
+)
+{
+    if (CTX == core::os::CallingContext::NORMAL) {
+        free(objp);
+    } else {
+        SysLock::ScopeFrom<CTX> lock;
+        (void)lock;
+
+        free_unsafe(objp);
+    }
+}
+
 template <typename Item>
 inline
 void
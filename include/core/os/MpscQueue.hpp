@@ -0,0 +1,360 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/common.hpp>
+#include <core/os/common.hpp>
+
+#include <core/os/SysLock.hpp>
+#include <core/os/MemoryPool.hpp>
+#include <core/os/SpinEvent.hpp>
+#include <core/os/Semaphore.hpp>
+#include <core/os/Atomic.hpp>
+
+#include <new>
+
+NAMESPACE_CORE_OS_BEGIN
+
+/*! \brief Lock-free multiple producer, single consumer queue
+ *
+ * Intrusive queue in the style of D. Vyukov: posting a node costs an atomic exchange and a store,
+ * whatever the number of producers. Producers can be threads or ISRs, the consumer must be a single thread.
+ *
+ * Nodes come from a MemoryPool. The consumer drains the whole batch with MpscQueue::drain and
+ * gives all the nodes back to the pool within a single system lock.
+ *
+ * An optional notifier (a SpinEvent bit or a Semaphore) is signalled once per batch:
+ * after a drain, only the first post signals it again.
+ *
+ * \tparam T item type, must be default constructible and copy assignable
+ */
+template <typename T>
+class MpscQueue:
+    private core::Uncopyable
+{
+public:
+    struct Link {
+        Atomic<Link*> next;
+    };
+
+    /*! \brief Queue node
+     *
+     */
+    struct Node:
+        public Link {
+        T value; //!< item
+    };
+
+    using Pool = MemoryPool<Node>; //!< Pool the nodes are taken from
+
+public:
+    /*! \brief Signals a SpinEvent bit when a batch becomes available
+     *
+     * \warning Must be called before the producers start.
+     */
+    void
+    set_notifier(
+        SpinEvent& event, //!< [in] event of the consumer thread
+        unsigned   event_index //!< [in] event bit to signal
+    );
+
+
+    /*! \brief Signals a Semaphore when a batch becomes available
+     *
+     * \warning Must be called before the producers start.
+     */
+    void
+    set_notifier(
+        Semaphore& semaphore //!< [in] semaphore the consumer waits on
+    );
+
+
+    /*! \brief Allocates a node from the pool [producer]
+     *
+     * \return the node
+     * \retval nullptr the pool is exhausted
+     *
+     * \tparam CTX calling context
+     */
+    template <core::os::CallingContext CTX = core::os::CallingContext::NORMAL>
+    Node*
+    alloc();
+
+
+    /*! \brief Appends a node obtained with MpscQueue::alloc [producer]
+     *
+     * \tparam CTX calling context, used only to signal the notifier
+     */
+    template <core::os::CallingContext CTX = core::os::CallingContext::NORMAL>
+    void
+    post(
+        Node* node //!< [in] node to append
+    );
+
+
+    /*! \brief Copies an item into a new node and appends it [producer]
+     *
+     * \return Success
+     * \retval false the pool is exhausted
+     *
+     * \tparam CTX calling context
+     */
+    template <core::os::CallingContext CTX = core::os::CallingContext::NORMAL>
+    bool
+    post(
+        const T& value //!< [in] item to append
+    );
+
+
+    /*! \brief Removes all the available items [consumer]
+     *
+     * \c function is called with a reference to each item, in posting order.
+     * Once all of them have been processed the nodes are returned to the pool.
+     *
+     * \return number of items processed
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    template <typename Function>
+    std::size_t
+    drain(
+        Function function //!< [in] callable with a \c T& argument
+    );
+
+
+public:
+    MpscQueue(
+        Pool& pool //!< [in] pool the nodes are taken from
+    );
+
+private:
+    Node*
+    pop();
+
+    void
+    link(
+        Link* node
+    );
+
+    template <core::os::CallingContext CTX>
+    void
+    notify();
+
+private:
+    Atomic<Link*> _head; // last posted, shared by the producers
+    Link* _tail; // next to pop, consumer only
+    Link  _stub;
+    Atomic<bool> _pending;
+    Pool&      _pool;
+    SpinEvent* _event;
+    unsigned   _event_index;
+    Semaphore* _semaphore;
+};
+
+
+template <typename T>
+inline
+void
+MpscQueue<T>::set_notifier(
+    SpinEvent& event,
+    unsigned   event_index
+)
+{
+    CORE_ASSERT(event_index <= SpinEvent::MAX_INDEX);
+
+    _event       = &event;
+    _event_index = event_index;
+}
+
+template <typename T>
+inline
+void
+MpscQueue<T>::set_notifier(
+    Semaphore& semaphore
+)
+{
+    _semaphore = &semaphore;
+}
+
+template <typename T>
+template <core::os::CallingContext CTX>
+inline
+typename MpscQueue<T>::Node *
+MpscQueue<T>::alloc()
+{
+    Node* node = _pool.template alloc<CTX>();
+
+    if (node != nullptr) {
+        new (node) Node();
+    }
+
+    return node;
+}
+
+template <typename T>
+template <core::os::CallingContext CTX>
+inline
+void
+MpscQueue<T>::post(
+    Node* node
+)
+{
+    CORE_ASSERT(node != nullptr);
+
+    link(node);
+
+    if ((_event != nullptr) || (_semaphore != nullptr)) {
+        // Only the first post after a drain wakes the consumer up.
+        if (!_pending.exchange(true, MemoryOrder::ACQ_REL)) {
+            notify<CTX>();
+        }
+    }
+}
+
+template <typename T>
+template <core::os::CallingContext CTX>
+inline
+bool
+MpscQueue<T>::post(
+    const T& value
+)
+{
+    Node* node = alloc<CTX>();
+
+    if (node == nullptr) {
+        return false;
+    }
+
+    node->value = value;
+    post<CTX>(node);
+
+    return true;
+}
+
+template <typename T>
+template <typename Function>
+inline
+std::size_t
+MpscQueue<T>::drain(
+    Function function
+)
+{
+    std::size_t count = 0;
+    Link*       batch = nullptr;
+
+    // Re-arm the notifier before looking at the queue, so that any later post signals it.
+    // The exchange synchronizes with the producers that already posted.
+    (void)_pending.exchange(false, MemoryOrder::ACQ_REL);
+
+    for (Node* node = pop(); node != nullptr; node = pop()) {
+        function(node->value);
+
+        // The producers are done with a popped node, its link can be reused for the batch.
+        node->next.store(batch, MemoryOrder::RELAXED);
+        batch = node;
+        count++;
+    }
+
+    if (batch != nullptr) {
+        SysLock::Scope lock;
+
+        while (batch != nullptr) {
+            Node* node = static_cast<Node*>(batch);
+            batch = batch->next.load(MemoryOrder::RELAXED);
+            node->~Node();
+            _pool.free_unsafe(node);
+        }
+    }
+
+    return count;
+} // drain
+
+template <typename T>
+inline
+typename MpscQueue<T>::Node *
+MpscQueue<T>::pop()
+{
+    Link* tail = _tail;
+    Link* next = tail->next.load(MemoryOrder::ACQUIRE);
+
+    if (tail == &_stub) {
+        if (next == nullptr) {
+            return nullptr;
+        }
+
+        _tail = next;
+        tail  = next;
+        next  = next->next.load(MemoryOrder::ACQUIRE);
+    }
+
+    if (next != nullptr) {
+        _tail = next;
+        return static_cast<Node*>(tail);
+    }
+
+    if (tail != _head.load(MemoryOrder::ACQUIRE)) {
+        // A producer swapped the head but has not linked its node yet: it will be in the next batch.
+        return nullptr;
+    }
+
+    // Re-insert the stub, so that the last node can be handed out.
+    link(&_stub);
+
+    next = tail->next.load(MemoryOrder::ACQUIRE);
+
+    if (next != nullptr) {
+        _tail = next;
+        return static_cast<Node*>(tail);
+    }
+
+    return nullptr;
+} // pop
+
+template <typename T>
+inline
+void
+MpscQueue<T>::link(
+    Link* node
+)
+{
+    node->next.store(nullptr, MemoryOrder::RELAXED);
+
+    Link* prev = _head.exchange(node, MemoryOrder::ACQ_REL);
+
+    prev->next.store(node, MemoryOrder::RELEASE);
+}
+
+template <typename T>
+template <core::os::CallingContext CTX>
+inline
+void
+MpscQueue<T>::notify()
+{
+    SysLock::ScopeFrom<CTX> lock;
+    (void)lock;
+
+    if (_event != nullptr) {
+        _event->signal_unsafe(_event_index);
+    }
+
+    if (_semaphore != nullptr) {
+        _semaphore->signal_unsafe();
+    }
+}
+
+template <typename T>
+inline
+MpscQueue<T>::MpscQueue(
+    Pool& pool
+)
+    :
+    _head(&_stub), _tail(&_stub), _stub(), _pending(false), _pool(pool), _event(nullptr), _event_index(0), _semaphore(nullptr)
+{
+    _stub.next.store(nullptr, MemoryOrder::RELAXED);
+}
+
+NAMESPACE_CORE_OS_END
@@ -11,17 +11,58 @@
 
 #include <core/os/impl/Mutex_.hpp>
 
+#ifndef CORE_MUTEX_STATS
+#define CORE_MUTEX_STATS false
+#endif
+
+#if CORE_MUTEX_STATS
+#include <core/os/OS.hpp>
+#include <core/os/Thread.hpp>
+#include <core/os/impl/SysLock_.hpp>
+#include <cstring>
+#endif
+
 NAMESPACE_CORE_OS_BEGIN
 
 /*! \brief Mutex
  *
+ * When \c CORE_MUTEX_STATS is true every mutex keeps contention statistics,
+ * and named mutexes are linked in a registry that can be walked with Mutex::get_first and Mutex::get_next.
  */
 class Mutex:
     private core::Uncopyable
 {
+#if CORE_MUTEX_STATS
+public:
+    /*! \brief Contention statistics
+     *
+     * Times are expressed in OS::RealtimeCounter units.
+     */
+    struct Stats {
+        enum {
+            HISTOGRAM_BUCKETS = 8
+        };
+
+        uint32_t acquired; //!< Number of acquisitions
+        uint32_t contended; //!< Number of acquisitions that had to wait
+        uint64_t total_wait; //!< Sum of all the waits
+        uint32_t max_wait; //!< Longest wait
+        uint32_t max_hold; //!< Longest ownership
+        Thread*  last_contender; //!< Last thread that had to wait
+        uint32_t wait_histogram[HISTOGRAM_BUCKETS]; //!< Bucket \c i counts the waits shorter than 16^(i+1)
+    };
+#endif
+
 private:
     Mutex_ impl;
 
+#if CORE_MUTEX_STATS
+    const char* _name;
+    Mutex*      _next;
+    Stats       _stats;
+    OS::RealtimeCounter _acquired_at;
+#endif
+
 public:
     /*! \brief Initialize the mutex
      *
@@ -50,6 +91,18 @@ public:
     release_unsafe();
 
 
+    /*! \brief Try to acquire ownership
+     *
+     * \return Success
+     * \retval true the mutex has been acquired
+     * \retval false the mutex is owned by another thread
+     *
+     * \warning Must be used only in a system lock zone by threads only.
+     */
+    bool
+    try_acquire_unsafe();
+
+
     /*! \brief Acquire ownership
      *
      * If the mutex is already owned, the requesting thread is put to sleep and queued.
@@ -70,12 +123,141 @@ public:
     release();
 
 
+    /*! \brief Try to acquire ownership
+     *
+     * \return Success
+     * \retval true the mutex has been acquired
+     * \retval false the mutex is owned by another thread
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    bool
+    try_acquire();
+
+
+    /*! \brief Acquire ownership, with the locking required by \c CTX
+     *
+     * \tparam CTX calling context, NORMAL or SYSLOCK (threads only)
+     */
+    template <core::os::CallingContext CTX>
+    void
+    acquire();
+
+
+    /*! \brief Relinquishes ownership, with the locking required by \c CTX
+     *
+     * \pre The invoking thread must have the ownership of the mutex
+     *
+     * \tparam CTX calling context, NORMAL or SYSLOCK (threads only)
+     */
+    template <core::os::CallingContext CTX>
+    void
+    release();
+
+
+    /*! \brief Try to acquire ownership, with the locking required by \c CTX
+     *
+     * \return Success
+     * \retval true the mutex has been acquired
+     * \retval false the mutex is owned by another thread
+     *
+     * \tparam CTX calling context, NORMAL or SYSLOCK (threads only)
+     */
+    template <core::os::CallingContext CTX>
+    bool
+    try_acquire();
+
+
+#if CORE_MUTEX_STATS
+    /*! \brief Gets the name of the mutex
+     *
+     * \retval \c nullptr if the mutex has not been named
+     */
+    const char*
+    get_name() const;
+
+
+    /*! \brief Gets the contention statistics
+     *
+     * \note The statistics are updated by the owner, so they are only guaranteed to be consistent while holding the mutex.
+     */
+    const Stats&
+    get_stats() const;
+
+
+    /*! \brief Clears the contention statistics
+     *
+     * \warning Must not be called while owning the mutex.
+     */
+    void
+    reset_stats();
+
+
+    /*! \brief Gets the next named mutex in the registry
+     *
+     * \retval \c nullptr this is the last one
+     */
+    Mutex*
+    get_next() const;
+
+
+    /*! \brief Gets the first named mutex in the registry
+     *
+     * \retval \c nullptr there are no named mutexes
+     */
+    static Mutex*
+    get_first();
+
+
+    /*! \brief Looks up a named mutex in the registry
+     *
+     * \retval \c nullptr no mutex has the given name
+     */
+    static Mutex*
+    find(
+        const char* name //!< [in] name of the mutex
+    );
+#endif // if CORE_MUTEX_STATS
+
+
 public:
     Mutex();
     explicit
     Mutex(
         bool initialize
     );
+
+    /*! \brief Named mutex
+     *
+     * When \c CORE_MUTEX_STATS is true the mutex is added to the registry, otherwise the name is ignored.
+     * Named mutexes can be created and destroyed by static constructors, and from within a system lock zone.
+     *
+     * The name is a string literal, so that it outlives the mutex and \c Mutex(0) still means \c Mutex(false).
+     */
+    template <std::size_t N>
+    explicit
+    Mutex(
+        const char(&name)[N] //!< [in] name of the mutex
+    );
+
+#if CORE_MUTEX_STATS
+    ~Mutex();
+
+private:
+    void
+    stats_contended(
+        OS::RealtimeCounter wait
+    );
+
+    void
+    stats_acquired();
+
+    void
+    stats_released();
+
+    static Mutex*&
+    registry();
+#endif
 };
 
 
@@ -90,34 +272,246 @@ inline
 void
 Mutex::acquire_unsafe()
 {
+#if CORE_MUTEX_STATS
+    if (!impl.try_acquire_unsafe()) {
+        OS::RealtimeCounter start = OS::get_realtime_counter();
+        impl.acquire_unsafe();
+        stats_contended(OS::get_realtime_counter() - start);
+    }
+
+    stats_acquired();
+#else
     impl.acquire_unsafe();
+#endif
 }
 
 inline
 void
 Mutex::release_unsafe()
 {
+#if CORE_MUTEX_STATS
+    stats_released();
+#endif
     impl.release_unsafe();
 }
 
+inline
+bool
+Mutex::try_acquire_unsafe()
+{
+#if CORE_MUTEX_STATS
+    if (impl.try_acquire_unsafe()) {
+        stats_acquired();
+        return true;
+    }
+
+    return false;
+
+#else
+    return impl.try_acquire_unsafe();
+#endif
+}
+
 inline
 void
 Mutex::acquire()
 {
+#if CORE_MUTEX_STATS
+    if (!impl.try_acquire()) {
+        OS::RealtimeCounter start = OS::get_realtime_counter();
+        impl.acquire();
+        stats_contended(OS::get_realtime_counter() - start);
+    }
+
+    stats_acquired();
+#else
     impl.acquire();
+#endif
 }
 
 inline
 void
 Mutex::release()
 {
+#if CORE_MUTEX_STATS
+    stats_released();
+#endif
     impl.release();
 }
 
+inline
+bool
+Mutex::try_acquire()
+{
+#if CORE_MUTEX_STATS
+    if (impl.try_acquire()) {
+        stats_acquired();
+        return true;
+    }
+
+    return false;
+
+#else
+    return impl.try_acquire();
+#endif
+}
+
+template <core::os::CallingContext CTX>
+inline
+void
+Mutex::acquire()
+{
+    static_assert(CTX != core::os::CallingContext::ISR, "Mutexes cannot be used from ISRs");
+
+    if (CTX == core::os::CallingContext::NORMAL) {
+        acquire();
+    } else {
+        acquire_unsafe();
+    }
+}
+
+template <core::os::CallingContext CTX>
+inline
+void
+Mutex::release()
+{
+    static_assert(CTX != core::os::CallingContext::ISR, "Mutexes cannot be used from ISRs");
+
+    if (CTX == core::os::CallingContext::NORMAL) {
+        release();
+    } else {
+        release_unsafe();
+    }
+}
+
+template <core::os::CallingContext CTX>
+inline
+bool
+Mutex::try_acquire()
+{
+    static_assert(CTX != core::os::CallingContext::ISR, "Mutexes cannot be used from ISRs");
+
+    if (CTX == core::os::CallingContext::NORMAL) {
+        return try_acquire();
+    } else {
+        return try_acquire_unsafe();
+    }
+}
+
+#if CORE_MUTEX_STATS
+inline
+const char*
+Mutex::get_name() const
+{
+    return _name;
+}
+
+inline
+const Mutex::Stats&
+Mutex::get_stats() const
+{
+    return _stats;
+}
+
+inline
+void
+Mutex::reset_stats()
+{
+    impl.acquire();
+    std::memset(&_stats, 0, sizeof(_stats));
+    impl.release();
+}
+
+inline
+Mutex*
+Mutex::get_next() const
+{
+    return _next;
+}
+
+inline
+Mutex*
+Mutex::get_first()
+{
+    return registry();
+}
+
+inline
+Mutex*
+Mutex::find(
+    const char* name
+)
+{
+    for (Mutex* mutex = registry(); mutex != nullptr; mutex = mutex->_next) {
+        if (std::strcmp(mutex->_name, name) == 0) {
+            return mutex;
+        }
+    }
+
+    return nullptr;
+}
+
+inline
+void
+Mutex::stats_contended(
+    OS::RealtimeCounter wait
+)
+{
+    // Called with the mutex owned, so the owner is the only writer.
+    unsigned bits   = (wait != 0) ? (32 - __builtin_clz(wait)) : 0;
+    unsigned bucket = (bits != 0) ? ((bits - 1) / 4) : 0;
+
+    _stats.contended++;
+    _stats.total_wait    += wait;
+    _stats.last_contender = &Thread::self();
+
+    if (wait > _stats.max_wait) {
+        _stats.max_wait = wait;
+    }
+
+    if (bucket >= Stats::HISTOGRAM_BUCKETS) {
+        bucket = Stats::HISTOGRAM_BUCKETS - 1;
+    }
+
+    _stats.wait_histogram[bucket]++;
+}
+
+inline
+void
+Mutex::stats_acquired()
+{
+    _stats.acquired++;
+    _acquired_at = OS::get_realtime_counter();
+}
+
+inline
+void
+Mutex::stats_released()
+{
+    OS::RealtimeCounter hold = OS::get_realtime_counter() - _acquired_at;
+
+    if (hold > _stats.max_hold) {
+        _stats.max_hold = hold;
+    }
+}
+
+inline
+Mutex*&
+Mutex::registry()
+{
+    static Mutex* first = nullptr;
+
+    return first;
+}
+#endif // if CORE_MUTEX_STATS
+
 inline
 Mutex::Mutex()
     :
     impl()
+#if CORE_MUTEX_STATS
+    , _name(nullptr), _next(nullptr), _stats(), _acquired_at(0)
+#endif
 {}
 
 
@@ -127,7 +521,53 @@ Mutex::Mutex(
 )
     :
     impl(initialize)
+#if CORE_MUTEX_STATS
+    , _name(nullptr), _next(nullptr), _stats(), _acquired_at(0)
+#endif
 {}
 
 
+template <std::size_t N>
+inline
+Mutex::Mutex(
+    const char(&name)[N]
+)
+    :
+    impl()
+#if CORE_MUTEX_STATS
+    , _name(name), _next(nullptr), _stats(), _acquired_at(0)
+#endif
+{
+#if CORE_MUTEX_STATS
+    // Saves and restores the interrupt state: the registry may be populated by static constructors,
+    // before the kernel is running, or from within a system lock zone.
+    SysLock_::Status status = SysLock_::get_status_and_acquire();
+
+    _next      = registry();
+    registry() = this;
+    SysLock_::restore_status(status);
+#else
+    (void)name;
+#endif
+}
+
+#if CORE_MUTEX_STATS
+inline
+Mutex::~Mutex()
+{
+    if (_name != nullptr) {
+        SysLock_::Status status = SysLock_::get_status_and_acquire();
+
+        for (Mutex** link = &registry(); *link != nullptr; link = &(*link)->_next) {
+            if (*link == this) {
+                *link = _next;
+                break;
+            }
+        }
+
+        SysLock_::restore_status(status);
+    }
+}
+#endif
+
 NAMESPACE_CORE_OS_END
@@ -16,6 +16,9 @@ NAMESPACE_CORE_OS_BEGIN
 class OS:
     private core::Uncopyable
 {
+public:
+    using RealtimeCounter = OS_::RealtimeCounter; //!< Free running high resolution counter type
+
 public:
     static void
     initialize();
@@ -31,6 +34,13 @@ public:
     static void
     disable();
 
+    /*! \brief Reads the free running high resolution counter
+     *
+     * On ports with a cycle counter this has CPU clock resolution, otherwise it falls back to system ticks.
+     */
+    static RealtimeCounter
+    get_realtime_counter();
+
 
 private:
     OS();
@@ -64,4 +74,10 @@ OS::disable()
     OS_::disable();
 }
 
+inline OS::RealtimeCounter
+OS::get_realtime_counter()
+{
+    return OS_::get_realtime_counter();
+}
+
 NAMESPACE_CORE_OS_END
@@ -0,0 +1,155 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/common.hpp>
+#include <core/os/common.hpp>
+
+#include <core/os/Time.hpp>
+
+#include <core/os/impl/Pipe_.hpp>
+
+NAMESPACE_CORE_OS_BEGIN
+
+/*! \brief Byte stream between threads
+ *
+ * Reads and writes of any length are copied in bulk, outside the system lock.
+ * In direct mode a writer finding a reader blocked on an empty pipe copies straight into the reader buffer,
+ * so the data is copied once instead of twice.
+ *
+ * \code{.cpp}
+ * core::os::Pipe<256> pipe;
+ *
+ * // Producer
+ * pipe.write(frame, sizeof(frame));
+ *
+ * // Consumer
+ * std::size_t n = pipe.read(buffer, sizeof(buffer), core::os::Time::ms(10));
+ * \endcode
+ *
+ * Concurrent readers (and writers) are serialised, so each transfer is contiguous in the stream.
+ *
+ * \tparam N buffer size, in bytes
+ */
+template <std::size_t N>
+class Pipe:
+    private core::Uncopyable
+{
+    static_assert(N > 0, "Pipe buffer cannot be empty");
+
+public:
+    /*! \brief Size of the buffer
+     *
+     */
+    std::size_t
+    get_size() const;
+
+
+    /*! \brief Number of bytes in the buffer
+     *
+     * Data copied directly into a reader buffer is never counted.
+     */
+    std::size_t
+    get_count() const;
+
+
+    /*! \brief Writes bytes
+     *
+     * Blocks until all the bytes have been written, or \c timeout expires.
+     * The timeout does not include the time spent waiting for other writers.
+     *
+     * \return number of bytes written, less than \c length on timeout
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    std::size_t
+    write(
+        const void* datap, //!< [in] data
+        std::size_t length, //!< [in] number of bytes
+        const Time& timeout = Time::INFINITE //!< [in] timeout
+    );
+
+
+    /*! \brief Reads bytes
+     *
+     * Blocks until \c length bytes have been read, or \c timeout expires.
+     * The timeout does not include the time spent waiting for other readers.
+     *
+     * \return number of bytes read, less than \c length on timeout
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    std::size_t
+    read(
+        void*       datap, //!< [out] data
+        std::size_t length, //!< [in] number of bytes
+        const Time& timeout = Time::INFINITE //!< [in] timeout
+    );
+
+
+public:
+    explicit
+    Pipe(
+        bool direct = true //!< [in] copy directly into blocked readers
+    );
+
+private:
+    uint8_t _buffer[N];
+    Pipe_   impl;
+};
+
+
+template <std::size_t N>
+inline
+std::size_t
+Pipe<N>::get_size() const
+{
+    return impl.get_size();
+}
+
+template <std::size_t N>
+inline
+std::size_t
+Pipe<N>::get_count() const
+{
+    return impl.get_count();
+}
+
+template <std::size_t N>
+inline
+std::size_t
+Pipe<N>::write(
+    const void* datap,
+    std::size_t length,
+    const Time& timeout
+)
+{
+    return impl.write(reinterpret_cast<const uint8_t*>(datap), length, timeout);
+}
+
+template <std::size_t N>
+inline
+std::size_t
+Pipe<N>::read(
+    void*       datap,
+    std::size_t length,
+    const Time& timeout
+)
+{
+    return impl.read(reinterpret_cast<uint8_t*>(datap), length, timeout);
+}
+
+template <std::size_t N>
+inline
+Pipe<N>::Pipe(
+    bool direct
+)
+    :
+    _buffer(), impl(_buffer, N, direct)
+{}
+
+NAMESPACE_CORE_OS_END
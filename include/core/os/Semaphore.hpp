@@ -9,6 +9,8 @@
 #include <core/common.hpp>
 #include <core/os/common.hpp>
 
+#include <core/os/SysLock.hpp>
+
 #include <core/os/impl/Semaphore_.hpp>
 
 NAMESPACE_CORE_OS_BEGIN
@@ -45,6 +47,42 @@ public:
         const Time& timeout
     );
 
+
+    /*! \brief Signals the semaphore \c count times
+     *
+     * \warning Must be used only in a system lock zone (threads and ISRs).
+     */
+    void
+    signal_n_unsafe(
+        Count count //!< [in] number of signals, greater than 0
+    );
+
+
+    /*! \brief Waits on the semaphore \c count times
+     *
+     * \warning Must be used only in a system lock zone by threads only.
+     */
+    void
+    wait_n_unsafe(
+        Count count //!< [in] number of waits, greater than 0
+    );
+
+
+    /*! \brief Waits on the semaphore \c count times, within a timeout
+     *
+     * All or nothing: on timeout the units already taken are given back.
+     *
+     * \return \c true if all the units have been taken before \c timeout expired
+     *
+     * \warning Must be used only in a system lock zone by threads only.
+     */
+    bool
+    wait_n_unsafe(
+        Count       count, //!< [in] number of waits, greater than 0
+        const Time& timeout //!< [in] timeout for the whole batch
+    );
+
+
     void
     reset(
         Count value = 0
@@ -62,6 +100,74 @@ public:
     );
 
 
+    /*! \brief Signals the semaphore \c count times
+     *
+     * One critical section and at most one reschedule for the whole batch.
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    void
+    signal_n(
+        Count count //!< [in] number of signals, greater than 0
+    );
+
+
+    /*! \brief Waits on the semaphore \c count times
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    void
+    wait_n(
+        Count count //!< [in] number of waits, greater than 0
+    );
+
+
+    /*! \brief Waits on the semaphore \c count times, within a timeout
+     *
+     * All or nothing: on timeout the units already taken are given back.
+     *
+     * \return \c true if all the units have been taken before \c timeout expired
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    bool
+    wait_n(
+        Count       count, //!< [in] number of waits, greater than 0
+        const Time& timeout //!< [in] timeout for the whole batch
+    );
+
+
+    /*! \brief Signals the semaphore, with the locking required by \c CTX
+     *
+     * \tparam CTX calling context
+     */
+    template <core::os::CallingContext CTX>
+    void
+    signal();
+
+
+    /*! \brief Waits on the semaphore, with the locking required by \c CTX
+     *
+     * \tparam CTX calling context, NORMAL or SYSLOCK (threads only)
+     */
+    template <core::os::CallingContext CTX>
+    void
+    wait();
+
+
+    /*! \brief Waits on the semaphore within a timeout, with the locking required by \c CTX
+     *
+     * \return \c true if the semaphore has been taken before \c timeout expired
+     *
+     * \tparam CTX calling context, NORMAL or SYSLOCK (threads only)
+     */
+    template <core::os::CallingContext CTX>
+    bool
+    wait(
+        const Time& timeout //!< [in] timeout
+    );
+
+
 public:
     Semaphore(
         Count value = 0
@@ -115,6 +221,34 @@ Semaphore::wait_unsafe(
     return impl.wait_unsafe(timeout);
 }
 
+inline
+void
+Semaphore::signal_n_unsafe(
+    Count count
+)
+{
+    impl.signal_n_unsafe(count);
+}
+
+inline
+void
+Semaphore::wait_n_unsafe(
+    Count count
+)
+{
+    impl.wait_n_unsafe(count);
+}
+
+inline
+bool
+Semaphore::wait_n_unsafe(
+    Count       count,
+    const Time& timeout
+)
+{
+    return impl.wait_n_unsafe(count, timeout);
+}
+
 inline
 void
 Semaphore::reset(
@@ -147,6 +281,79 @@ Semaphore::wait(
     return impl.wait(timeout);
 }
 
+inline
+void
+Semaphore::signal_n(
+    Count count
+)
+{
+    impl.signal_n(count);
+}
+
+inline
+void
+Semaphore::wait_n(
+    Count count
+)
+{
+    impl.wait_n(count);
+}
+
+inline
+bool
+Semaphore::wait_n(
+    Count       count,
+    const Time& timeout
+)
+{
+    return impl.wait_n(count, timeout);
+}
+
+template <core::os::CallingContext CTX>
+inline
+void
+Semaphore::signal()
+{
+    if (CTX == core::os::CallingContext::NORMAL) {
+        signal();
+    } else {
+        SysLock::ScopeFrom<CTX> lock;
+        (void)lock;
+
+        signal_unsafe();
+    }
+}
+
+template <core::os::CallingContext CTX>
+inline
+void
+Semaphore::wait()
+{
+    static_assert(CTX != core::os::CallingContext::ISR, "Cannot wait on a semaphore from an ISR");
+
+    if (CTX == core::os::CallingContext::NORMAL) {
+        wait();
+    } else {
+        wait_unsafe();
+    }
+}
+
+template <core::os::CallingContext CTX>
+inline
+bool
+Semaphore::wait(
+    const Time& timeout
+)
+{
+    static_assert(CTX != core::os::CallingContext::ISR, "Cannot wait on a semaphore from an ISR");
+
+    if (CTX == core::os::CallingContext::NORMAL) {
+        return wait(timeout);
+    } else {
+        return wait_unsafe(timeout);
+    }
+}
+
 inline
 Semaphore::Semaphore(
     Count value
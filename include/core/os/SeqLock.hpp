@@ -0,0 +1,249 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/common.hpp>
+#include <core/os/common.hpp>
+
+#include <core/os/Atomic.hpp>
+
+#include <cstring>
+
+NAMESPACE_CORE_OS_BEGIN
+
+/*! \brief Sequence lock
+ *
+ * Publishes a value from a single writer to any number of readers.
+ * The writer never waits, so it can be a thread or an ISR; readers never block it,
+ * they copy the value optimistically and retry if a write happened meanwhile.
+ *
+ * \code{.cpp}
+ * core::os::SeqLock<Attitude> attitude;
+ *
+ * // Writer (e.g. ISR)
+ * attitude.write(sample);
+ *
+ * // Readers
+ * Attitude copy = attitude.read();
+ * \endcode
+ *
+ * \warning On a single core a reader spinning in SeqLock::read never lets a preempted writer complete.
+ * Readers that can preempt the writer (higher priority threads when the writer is a thread, or ISRs)
+ * must use SeqLock::try_read.
+ *
+ * \warning Multiple writers must be serialized externally.
+ *
+ * \tparam T value type, must be trivially copyable
+ */
+template <typename T>
+class SeqLock:
+    private core::Uncopyable
+{
+public:
+    using Sequence = uint32_t; //!< Sequence number type
+
+public:
+    /*! \brief Publishes a new value [writer]
+     *
+     */
+    void
+    write(
+        const T& value //!< [in] new value
+    );
+
+
+    /*! \brief Modifies the value in place [writer]
+     *
+     * \c function is called with a reference to the value, readers retry until it returns.
+     */
+    template <typename Function>
+    void
+    update(
+        Function function //!< [in] callable with a \c T& argument
+    );
+
+
+    /*! \brief Tries to copy the value once [reader]
+     *
+     * \return Success
+     * \retval false a write was in progress, \c value is not consistent
+     */
+    bool
+    try_read(
+        T& value //!< [out] copy of the value
+    ) const;
+
+
+    /*! \brief Copies the value, retrying until it is consistent [reader]
+     *
+     */
+    void
+    read(
+        T& value //!< [out] copy of the value
+    ) const;
+
+
+    /*! \brief Copies the value, retrying until it is consistent [reader]
+     *
+     * \return copy of the value
+     */
+    T
+    read() const;
+
+
+    /*! \brief Gets the current sequence number
+     *
+     * It is even when no write is in progress and increases by 2 at every write,
+     * so readers can tell if the value changed since their last read.
+     */
+    Sequence
+    get_sequence() const;
+
+
+public:
+    SeqLock();
+    explicit
+    SeqLock(
+        const T& value //!< [in] initial value
+    );
+
+private:
+    Sequence
+    begin_write();
+
+    void
+    end_write(
+        Sequence sequence
+    );
+
+private:
+    Atomic<Sequence> _sequence;
+    T _value;
+};
+
+
+template <typename T>
+inline
+void
+SeqLock<T>::write(
+    const T& value
+)
+{
+    Sequence sequence = begin_write();
+
+    std::memcpy(&_value, &value, sizeof(T));
+    end_write(sequence);
+}
+
+template <typename T>
+template <typename Function>
+inline
+void
+SeqLock<T>::update(
+    Function function
+)
+{
+    Sequence sequence = begin_write();
+
+    function(_value);
+    end_write(sequence);
+}
+
+template <typename T>
+inline
+bool
+SeqLock<T>::try_read(
+    T& value
+) const
+{
+    Sequence begin = _sequence.load(MemoryOrder::ACQUIRE);
+
+    if ((begin & 1) != 0) {
+        return false;
+    }
+
+    std::memcpy(&value, &_value, sizeof(T));
+
+    // Keep the copy above the check below.
+    atomic_fence(MemoryOrder::ACQUIRE);
+
+    return _sequence.load(MemoryOrder::RELAXED) == begin;
+}
+
+template <typename T>
+inline
+void
+SeqLock<T>::read(
+    T& value
+) const
+{
+    while (!try_read(value)) {}
+}
+
+template <typename T>
+inline
+T
+SeqLock<T>::read() const
+{
+    T value;
+
+    read(value);
+    return value;
+}
+
+template <typename T>
+inline
+typename SeqLock<T>::Sequence
+SeqLock<T>::get_sequence() const
+{
+    return _sequence.load(MemoryOrder::ACQUIRE);
+}
+
+template <typename T>
+inline
+typename SeqLock<T>::Sequence
+SeqLock<T>::begin_write()
+{
+    Sequence sequence = _sequence.load(MemoryOrder::RELAXED);
+
+    _sequence.store(sequence + 1, MemoryOrder::RELAXED);
+
+    // Make the odd sequence visible before any change to the value.
+    atomic_fence(MemoryOrder::RELEASE);
+
+    return sequence;
+}
+
+template <typename T>
+inline
+void
+SeqLock<T>::end_write(
+    Sequence sequence
+)
+{
+    _sequence.store(sequence + 2, MemoryOrder::RELEASE);
+}
+
+template <typename T>
+inline
+SeqLock<T>::SeqLock()
+    :
+    _sequence(0), _value()
+{}
+
+
+template <typename T>
+inline
+SeqLock<T>::SeqLock(
+    const T& value
+)
+    :
+    _sequence(0), _value(value)
+{}
+
+
+NAMESPACE_CORE_OS_END
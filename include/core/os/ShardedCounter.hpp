@@ -0,0 +1,190 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/common.hpp>
+#include <core/os/common.hpp>
+
+#include <core/os/Thread.hpp>
+#include <core/os/Atomic.hpp>
+
+#ifndef CORE_CACHE_LINE_SIZE
+#define CORE_CACHE_LINE_SIZE 32
+#endif
+
+NAMESPACE_CORE_OS_BEGIN
+
+/*! \brief Counter updated by many threads without locks
+ *
+ * The count is split in \c SHARDS slots, each on its own cache line (\c CORE_CACHE_LINE_SIZE bytes).
+ * A thread adds to the slot picked by hashing its Thread pointer, or to an explicit one,
+ * so threads running on different cores or caches do not fight over the same line.
+ * The total is the sum of the slots, computed on read.
+ *
+ * \code{.cpp}
+ * static core::os::ShardedCounter<8> rx_packets;
+ *
+ * // Any thread or ISR
+ * rx_packets.add();
+ *
+ * // Statistics
+ * uint32_t total = rx_packets.get();
+ * \endcode
+ *
+ * Updates are relaxed atomic additions, they can be used from any context.
+ * A read racing with updates may miss the latest ones, but never counts twice.
+ *
+ * \note Updates are lock-free only on cores with exclusive load/store (Cortex-M3 and above).
+ * On the others (Cortex-M0) Atomic falls back to a short critical section, disabling interrupts for each update;
+ * code relying on lock-free counting should check ShardedCounter::LOCK_FREE with a \c static_assert.
+ *
+ * \warning Slots are cache-line aligned only in static storage, or from allocators honouring the alignment.
+ *
+ * \tparam SHARDS number of slots, typically the number of updating threads
+ * \tparam T counter type, up to the word size
+ */
+template <std::size_t SHARDS, typename T = uint32_t>
+class ShardedCounter
+{
+    static_assert(SHARDS > 0, "ShardedCounter needs at least a slot");
+
+public:
+    typedef T Value;
+
+    enum : bool {
+        LOCK_FREE = CORE_ATOMIC_LOCK_FREE_ //!< Updates never disable interrupts
+    };
+
+public:
+    /*! \brief Adds to the slot of the calling thread
+     *
+     */
+    void
+    add(
+        Value value = 1 //!< [in] amount to add
+    );
+
+
+    /*! \brief Adds to an explicit slot
+     *
+     * Threads owning a slot each never share a cache line.
+     */
+    void
+    add_to(
+        std::size_t shard, //!< [in] slot index, less than \c SHARDS
+        Value       value = 1 //!< [in] amount to add
+    );
+
+
+    /*! \brief Gets the slot of the calling thread
+     *
+     * Can be cached by the thread and passed to ShardedCounter::add_to.
+     */
+    static std::size_t
+    get_shard();
+
+
+    /*! \brief Gets the total
+     *
+     */
+    Value
+    get() const;
+
+
+    /*! \brief Clears all the slots
+     *
+     * \warning Updates made while clearing may be lost.
+     */
+    void
+    reset();
+
+
+public:
+    ShardedCounter();
+
+private:
+    struct alignas(CORE_CACHE_LINE_SIZE) Slot {
+        Atomic<Value> value;
+    };
+
+private:
+    Slot _slots[SHARDS];
+};
+
+
+template <std::size_t SHARDS, typename T>
+inline
+void
+ShardedCounter<SHARDS, T>::add(
+    Value value
+)
+{
+    _slots[get_shard()].value.fetch_add(value, MemoryOrder::RELAXED);
+}
+
+template <std::size_t SHARDS, typename T>
+inline
+void
+ShardedCounter<SHARDS, T>::add_to(
+    std::size_t shard,
+    Value       value
+)
+{
+    CORE_ASSERT(shard < SHARDS);
+
+    _slots[shard].value.fetch_add(value, MemoryOrder::RELAXED);
+}
+
+template <std::size_t SHARDS, typename T>
+inline
+std::size_t
+ShardedCounter<SHARDS, T>::get_shard()
+{
+    if (SHARDS == 1) {
+        return 0;
+    }
+
+    // Threads sit at the base of 8 byte aligned working areas: drop the low bits, then spread the rest (Fibonacci hashing).
+    uint32_t key = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&Thread::self()) >> 3);
+
+    return static_cast<std::size_t>((key * 2654435761u) >> 16) % SHARDS;
+}
+
+template <std::size_t SHARDS, typename T>
+inline
+typename ShardedCounter<SHARDS, T>::Value
+ShardedCounter<SHARDS, T>::get() const
+{
+    Value total = 0;
+
+    for (std::size_t shard = 0; shard < SHARDS; shard++) {
+        total += _slots[shard].value.load(MemoryOrder::RELAXED);
+    }
+
+    return total;
+}
+
+template <std::size_t SHARDS, typename T>
+inline
+void
+ShardedCounter<SHARDS, T>::reset()
+{
+    for (std::size_t shard = 0; shard < SHARDS; shard++) {
+        _slots[shard].value.store(0, MemoryOrder::RELAXED);
+    }
+}
+
+template <std::size_t SHARDS, typename T>
+inline
+ShardedCounter<SHARDS, T>::ShardedCounter()
+    :
+    _slots()
+{
+    reset();
+}
+
+NAMESPACE_CORE_OS_END
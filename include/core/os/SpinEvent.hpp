@@ -12,16 +12,27 @@
 #include <core/os/Time.hpp>
 #include <core/os/Thread.hpp>
 
+#include <core/os/SysLock.hpp>
+
 #include <core/os/impl/SpinEvent_.hpp>
 
 NAMESPACE_CORE_OS_BEGIN
 
-
+/*! \brief Thread event
+ *
+ * SpinEvent::wait can poll the pending events for a bounded number of cycles before blocking,
+ * so that a signal coming from an ISR shortly after the call is picked up without going through the scheduler.
+ * The spin phase is disabled by default; \c CORE_SPIN_EVENT_SPIN_CYCLES sets the default for all events,
+ * SpinEvent::set_spin changes it per event. It is only available on ports with a realtime counter.
+ *
+ * When \c CORE_SPIN_EVENT_STATS is true each event counts how many spin phases succeeded and how many ended up blocking.
+ */
 class SpinEvent:
     private core::Uncopyable
 {
 public:
-    typedef SpinEvent_::Mask Mask;
+    typedef SpinEvent_::Mask   Mask;
+    typedef SpinEvent_::Cycles Cycles;
 
     enum {
         MAX_INDEX = (sizeof(Mask) * 8) - 1
@@ -50,12 +61,65 @@ public:
         unsigned event_index
     );
 
+
+    /*! \brief Signals an event, with the locking required by \c CTX
+     *
+     * \tparam CTX calling context
+     */
+    template <core::os::CallingContext CTX>
+    void
+    signal(
+        unsigned event_index //!< [in] event bit
+    );
+
+
     Mask
     wait(
         const Time& timeout
     );
 
 
+    /*! \brief Gets the length of the spin phase
+     *
+     */
+    Cycles
+    get_spin() const;
+
+
+    /*! \brief Sets the length of the spin phase
+     *
+     * \warning Spinning only pays off when the signal comes from an ISR (or another core):
+     * a lower priority thread cannot run while the waiter spins.
+     */
+    void
+    set_spin(
+        Cycles cycles //!< [in] maximum number of cycles to poll before blocking, 0 to disable spinning
+    );
+
+
+#if CORE_SPIN_EVENT_STATS
+    /*! \brief Number of waits satisfied while spinning
+     *
+     */
+    uint32_t
+    get_spin_hits() const;
+
+
+    /*! \brief Number of spin phases that ended up blocking
+     *
+     */
+    uint32_t
+    get_spin_misses() const;
+
+
+    /*! \brief Clears the spin statistics
+     *
+     */
+    void
+    reset_spin_stats();
+#endif
+
+
 public:
     SpinEvent(
         Thread* threadp = & Thread::self()
@@ -98,6 +162,23 @@ SpinEvent::signal(
     impl.signal(event_index);
 }
 
+template <core::os::CallingContext CTX>
+inline
+void
+SpinEvent::signal(
+    unsigned event_index
+)
+{
+    if (CTX == core::os::CallingContext::NORMAL) {
+        signal(event_index);
+    } else {
+        SysLock::ScopeFrom<CTX> lock;
+        (void)lock;
+
+        signal_unsafe(event_index);
+    }
+}
+
 inline
 SpinEvent::Mask
 SpinEvent::wait(
@@ -107,6 +188,45 @@ SpinEvent::wait(
     return impl.wait(timeout);
 }
 
+inline
+SpinEvent::Cycles
+SpinEvent::get_spin() const
+{
+    return impl.get_spin();
+}
+
+inline
+void
+SpinEvent::set_spin(
+    Cycles cycles
+)
+{
+    impl.set_spin(cycles);
+}
+
+#if CORE_SPIN_EVENT_STATS
+inline
+uint32_t
+SpinEvent::get_spin_hits() const
+{
+    return impl.get_spin_hits();
+}
+
+inline
+uint32_t
+SpinEvent::get_spin_misses() const
+{
+    return impl.get_spin_misses();
+}
+
+inline
+void
+SpinEvent::reset_spin_stats()
+{
+    impl.reset_spin_stats();
+}
+#endif
+
 inline
 SpinEvent::SpinEvent(
     Thread* threadp
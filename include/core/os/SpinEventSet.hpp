@@ -0,0 +1,267 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/common.hpp>
+#include <core/os/common.hpp>
+
+#include <core/os/SysLock.hpp>
+#include <core/os/SpinEvent.hpp>
+
+NAMESPACE_CORE_OS_BEGIN
+
+/*! \brief Set of up to 1024 event sources for a single thread
+ *
+ * Extends a single SpinEvent bit to \c N sources with a two-level bitmap:
+ * signalling a source sets its leaf bit and the summary bit of its leaf word,
+ * and wakes the thread up only if nothing else was pending.
+ * The thread finds the ready sources with count-leading-zeros scans, in O(ready) time.
+ *
+ * \code{.cpp}
+ * core::os::SpinEventSet<256> channels(CHANNELS_EVENT);
+ *
+ * // Producers (threads)
+ * channels.signal(channel_id);
+ *
+ * // Consumer
+ * core::os::SpinEvent::Mask mask = event.wait(core::os::Time::INFINITE);
+ *
+ * if (mask & channels.get_mask()) {
+ *   channels.dispatch([](unsigned channel_id) {
+ *     service(channel_id);
+ *   });
+ * }
+ * \endcode
+ *
+ * \tparam N number of sources
+ */
+template <std::size_t N>
+class SpinEventSet:
+    private core::Uncopyable
+{
+public:
+    typedef uint32_t Word;
+
+    enum : std::size_t {
+        WORD_BITS = 32,
+        WORDS     = (N + WORD_BITS - 1) / WORD_BITS
+    };
+
+    static_assert((N > 0) && (WORDS <= WORD_BITS), "SpinEventSet supports up to 1024 sources");
+
+public:
+    /*! \brief Gets the thread to be signalled
+     *
+     */
+    Thread*
+    get_thread() const;
+
+
+    /*! \brief Sets the thread to be signalled
+     *
+     */
+    void
+    set_thread(
+        Thread* threadp //!< [in] thread to be signalled
+    );
+
+
+    /*! \brief Gets the SpinEvent mask used to wake up the thread
+     *
+     */
+    SpinEvent::Mask
+    get_mask() const;
+
+
+    /*! \brief Signals a source
+     *
+     * \warning Must be used only in a system lock zone (threads and ISRs).
+     */
+    void
+    signal_unsafe(
+        unsigned source //!< [in] source index, less than \c N
+    );
+
+
+    /*! \brief Signals a source
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    void
+    signal(
+        unsigned source //!< [in] source index, less than \c N
+    );
+
+
+    /*! \brief Checks if any source is pending
+     *
+     */
+    bool
+    is_pending() const;
+
+
+    /*! \brief Consumes all the pending sources
+     *
+     * \c function is called with the index of each pending source, in ascending order.
+     * Sources signalled while dispatching are left for the next call.
+     *
+     * \return number of sources dispatched
+     *
+     * \warning Must be used only outside a system lock zone, by the signalled thread.
+     */
+    template <typename Function>
+    std::size_t
+    dispatch(
+        Function function //!< [in] callable with an \c unsigned argument
+    );
+
+
+public:
+    SpinEventSet(
+        unsigned event_index, //!< [in] SpinEvent bit used to wake up the thread
+        Thread*  threadp = & Thread::self() //!< [in] thread to be signalled
+    );
+
+private:
+    enum : Word {
+        MSB = 0x80000000
+    };
+
+private:
+    SpinEvent _event;
+    unsigned  _event_index;
+    Word      _summary; // bit w set if _leaves[w] != 0, MSB first
+    Word      _leaves[WORDS]; // bit b of word w is source w * 32 + b, MSB first
+};
+
+
+template <std::size_t N>
+inline
+Thread*
+SpinEventSet<N>::get_thread() const
+{
+    return _event.get_thread();
+}
+
+template <std::size_t N>
+inline
+void
+SpinEventSet<N>::set_thread(
+    Thread* threadp
+)
+{
+    _event.set_thread(threadp);
+}
+
+template <std::size_t N>
+inline
+SpinEvent::Mask
+SpinEventSet<N>::get_mask() const
+{
+    return static_cast<SpinEvent::Mask>(1) << _event_index;
+}
+
+template <std::size_t N>
+inline
+void
+SpinEventSet<N>::signal_unsafe(
+    unsigned source
+)
+{
+    CORE_ASSERT(source < N);
+
+    unsigned word    = source / WORD_BITS;
+    Word     summary = _summary;
+
+    _leaves[word] |= MSB >> (source % WORD_BITS);
+    _summary       = summary | (MSB >> word);
+
+    // If something was already pending the thread has been signalled and has not dispatched yet.
+    if (summary == 0) {
+        _event.signal_unsafe(_event_index);
+    }
+}
+
+template <std::size_t N>
+inline
+void
+SpinEventSet<N>::signal(
+    unsigned source
+)
+{
+    SysLock::Scope lock;
+
+    signal_unsafe(source);
+}
+
+template <std::size_t N>
+inline
+bool
+SpinEventSet<N>::is_pending() const
+{
+    return _summary != 0;
+}
+
+template <std::size_t N>
+template <typename Function>
+inline
+std::size_t
+SpinEventSet<N>::dispatch(
+    Function function
+)
+{
+    Word        leaves[WORDS];
+    Word        summary;
+    std::size_t count = 0;
+
+    {
+        // Snapshot and clear only the words flagged in the summary.
+        SysLock::Scope lock;
+
+        summary  = _summary;
+        _summary = 0;
+
+        for (Word pending = summary; pending != 0; ) {
+            unsigned word = __builtin_clz(pending);
+
+            pending      &= ~(MSB >> word);
+            leaves[word]  = _leaves[word];
+            _leaves[word] = 0;
+        }
+    }
+
+    while (summary != 0) {
+        unsigned word = __builtin_clz(summary);
+        Word     leaf = leaves[word];
+
+        summary &= ~(MSB >> word);
+
+        while (leaf != 0) {
+            unsigned bit = __builtin_clz(leaf);
+
+            leaf &= ~(MSB >> bit);
+            function(static_cast<unsigned>(word * WORD_BITS + bit));
+            count++;
+        }
+    }
+
+    return count;
+} // dispatch
+
+template <std::size_t N>
+inline
+SpinEventSet<N>::SpinEventSet(
+    unsigned event_index,
+    Thread*  threadp
+)
+    :
+    _event(threadp), _event_index(event_index), _summary(0), _leaves()
+{
+    CORE_ASSERT(event_index <= SpinEvent::MAX_INDEX);
+}
+
+NAMESPACE_CORE_OS_END
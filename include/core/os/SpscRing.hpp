@@ -0,0 +1,471 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/common.hpp>
+#include <core/os/common.hpp>
+
+#include <core/os/SysLock.hpp>
+#include <core/os/SpinEvent.hpp>
+#include <core/os/Semaphore.hpp>
+#include <core/os/Atomic.hpp>
+
+NAMESPACE_CORE_OS_BEGIN
+
+/*! \brief Lock-free single producer, single consumer ring buffer
+ *
+ * Both ends are wait-free: no system lock is taken to move data.
+ * The producer can be a thread or an ISR, the consumer must be a single thread.
+ *
+ * An optional notifier (a SpinEvent bit or a Semaphore) is signalled only when the
+ * ring goes from empty to non-empty, so the consumer is expected to drain it completely before waiting again:
+ *
+ * \code{.cpp}
+ * while (true) {
+ *   while (ring.pop(sample)) {
+ *     process(sample);
+ *   }
+ *
+ *   event.wait(core::os::Time::INFINITE);
+ * }
+ * \endcode
+ *
+ * \tparam T item type
+ * \tparam N capacity, must be a power of two
+ */
+template <typename T, std::size_t N>
+class SpscRing:
+    private core::Uncopyable
+{
+    static_assert((N != 0) && ((N & (N - 1)) == 0), "SpscRing capacity must be a power of two");
+
+public:
+    /*! \brief Contiguous region of the ring
+     *
+     */
+    struct Span {
+        T*          data; //!< first item
+        std::size_t size; //!< number of items
+    };
+
+public:
+    /*! \brief Signals a SpinEvent bit when the ring becomes non-empty
+     *
+     * \warning Must be called before the producer starts.
+     */
+    void
+    set_notifier(
+        SpinEvent& event, //!< [in] event of the consumer thread
+        unsigned   event_index //!< [in] event bit to signal
+    );
+
+
+    /*! \brief Signals a Semaphore when the ring becomes non-empty
+     *
+     * \warning Must be called before the producer starts.
+     */
+    void
+    set_notifier(
+        Semaphore& semaphore //!< [in] semaphore the consumer waits on
+    );
+
+
+    /*! \brief Maximum number of items
+     *
+     */
+    static constexpr std::size_t
+    capacity()
+    {
+        return N;
+    }
+
+    /*! \brief Number of items in the ring
+     *
+     */
+    std::size_t
+    size() const;
+
+
+    /*! \brief Checks if the ring is empty
+     *
+     */
+    bool
+    empty() const;
+
+
+    /*! \brief Checks if the ring is full
+     *
+     */
+    bool
+    full() const;
+
+
+    /*! \brief Appends an item [producer]
+     *
+     * \return Success
+     * \retval false the ring is full
+     *
+     * \tparam CTX calling context, used only to signal the notifier
+     */
+    template <core::os::CallingContext CTX = core::os::CallingContext::NORMAL>
+    bool
+    push(
+        const T& item //!< [in] item to append
+    );
+
+
+    /*! \brief Appends up to \c count items [producer]
+     *
+     * \return number of items appended
+     *
+     * \tparam CTX calling context, used only to signal the notifier
+     */
+    template <core::os::CallingContext CTX = core::os::CallingContext::NORMAL>
+    std::size_t
+    push_n(
+        const T*    items, //!< [in] items to append
+        std::size_t count //!< [in] number of items
+    );
+
+
+    /*! \brief Gets the largest contiguous free region [producer]
+     *
+     * Fill the region in place and then make the items visible with SpscRing::commit_write.
+     * A second call may return the wrapped-around remainder.
+     */
+    Span
+    write_span();
+
+
+    /*! \brief Publishes items written into a SpscRing::write_span region [producer]
+     *
+     * \tparam CTX calling context, used only to signal the notifier
+     */
+    template <core::os::CallingContext CTX = core::os::CallingContext::NORMAL>
+    void
+    commit_write(
+        std::size_t count //!< [in] number of items written, not more than the span size
+    );
+
+
+    /*! \brief Removes the oldest item [consumer]
+     *
+     * \return Success
+     * \retval false the ring is empty
+     */
+    bool
+    pop(
+        T& item //!< [out] removed item
+    );
+
+
+    /*! \brief Removes up to \c count items [consumer]
+     *
+     * \return number of items removed
+     */
+    std::size_t
+    pop_n(
+        T*          items, //!< [out] removed items
+        std::size_t count //!< [in] maximum number of items
+    );
+
+
+    /*! \brief Gets the largest contiguous region of available items [consumer]
+     *
+     * Process the items in place and then release them with SpscRing::commit_read.
+     * A second call may return the wrapped-around remainder.
+     */
+    Span
+    read_span();
+
+
+    /*! \brief Releases items obtained with SpscRing::read_span [consumer]
+     *
+     */
+    void
+    commit_read(
+        std::size_t count //!< [in] number of items consumed, not more than the span size
+    );
+
+
+public:
+    SpscRing();
+
+private:
+    enum : std::size_t {
+        MASK = N - 1
+    };
+
+    template <core::os::CallingContext CTX>
+    void
+    notify();
+
+    bool
+    has_notifier() const;
+
+private:
+    Atomic<std::size_t> _head; // free running, written by the producer only
+    Atomic<std::size_t> _tail; // free running, written by the consumer only
+    SpinEvent* _event;
+    unsigned   _event_index;
+    Semaphore* _semaphore;
+    T _buffer[N];
+};
+
+
+template <typename T, std::size_t N>
+inline
+void
+SpscRing<T, N>::set_notifier(
+    SpinEvent& event,
+    unsigned   event_index
+)
+{
+    CORE_ASSERT(event_index <= SpinEvent::MAX_INDEX);
+
+    _event       = &event;
+    _event_index = event_index;
+}
+
+template <typename T, std::size_t N>
+inline
+void
+SpscRing<T, N>::set_notifier(
+    Semaphore& semaphore
+)
+{
+    _semaphore = &semaphore;
+}
+
+template <typename T, std::size_t N>
+inline
+std::size_t
+SpscRing<T, N>::size() const
+{
+    std::size_t tail = _tail.load(MemoryOrder::ACQUIRE);
+
+    return _head.load(MemoryOrder::ACQUIRE) - tail;
+}
+
+template <typename T, std::size_t N>
+inline
+bool
+SpscRing<T, N>::empty() const
+{
+    return size() == 0;
+}
+
+template <typename T, std::size_t N>
+inline
+bool
+SpscRing<T, N>::full() const
+{
+    return size() == N;
+}
+
+template <typename T, std::size_t N>
+template <core::os::CallingContext CTX>
+inline
+bool
+SpscRing<T, N>::push(
+    const T& item
+)
+{
+    std::size_t head = _head.load(MemoryOrder::RELAXED);
+
+    if ((head - _tail.load(MemoryOrder::ACQUIRE)) == N) {
+        return false;
+    }
+
+    _buffer[head & MASK] = item;
+    commit_write<CTX>(1);
+
+    return true;
+}
+
+template <typename T, std::size_t N>
+template <core::os::CallingContext CTX>
+inline
+std::size_t
+SpscRing<T, N>::push_n(
+    const T*    items,
+    std::size_t count
+)
+{
+    std::size_t head = _head.load(MemoryOrder::RELAXED);
+    std::size_t free = N - (head - _tail.load(MemoryOrder::ACQUIRE));
+
+    if (count > free) {
+        count = free;
+    }
+
+    for (std::size_t i = 0; i < count; i++) {
+        _buffer[(head + i) & MASK] = items[i];
+    }
+
+    if (count > 0) {
+        commit_write<CTX>(count);
+    }
+
+    return count;
+} // push_n
+
+template <typename T, std::size_t N>
+inline
+typename SpscRing<T, N>::Span
+SpscRing<T, N>::write_span()
+{
+    std::size_t head   = _head.load(MemoryOrder::RELAXED);
+    std::size_t free   = N - (head - _tail.load(MemoryOrder::ACQUIRE));
+    std::size_t offset = head & MASK;
+    Span        span;
+
+    span.data = &_buffer[offset];
+    span.size = ((N - offset) < free) ? (N - offset) : free;
+
+    return span;
+}
+
+template <typename T, std::size_t N>
+template <core::os::CallingContext CTX>
+inline
+void
+SpscRing<T, N>::commit_write(
+    std::size_t count
+)
+{
+    std::size_t head = _head.load(MemoryOrder::RELAXED);
+
+    CORE_ASSERT(count <= (N - (head - _tail.load(MemoryOrder::RELAXED))));
+
+    _head.store(head + count, MemoryOrder::RELEASE);
+
+    if (has_notifier() && (count > 0)) {
+        // Pairs with the fence in commit_read: either the consumer sees the new items,
+        // or we see that it had drained everything and may be going to sleep.
+        atomic_fence(MemoryOrder::SEQ_CST);
+
+        if (_tail.load(MemoryOrder::RELAXED) == head) {
+            notify<CTX>();
+        }
+    }
+}
+
+template <typename T, std::size_t N>
+inline
+bool
+SpscRing<T, N>::pop(
+    T& item
+)
+{
+    std::size_t tail = _tail.load(MemoryOrder::RELAXED);
+
+    if (_head.load(MemoryOrder::ACQUIRE) == tail) {
+        return false;
+    }
+
+    item = _buffer[tail & MASK];
+    commit_read(1);
+
+    return true;
+}
+
+template <typename T, std::size_t N>
+inline
+std::size_t
+SpscRing<T, N>::pop_n(
+    T*          items,
+    std::size_t count
+)
+{
+    std::size_t tail = _tail.load(MemoryOrder::RELAXED);
+    std::size_t used = _head.load(MemoryOrder::ACQUIRE) - tail;
+
+    if (count > used) {
+        count = used;
+    }
+
+    for (std::size_t i = 0; i < count; i++) {
+        items[i] = _buffer[(tail + i) & MASK];
+    }
+
+    if (count > 0) {
+        commit_read(count);
+    }
+
+    return count;
+} // pop_n
+
+template <typename T, std::size_t N>
+inline
+typename SpscRing<T, N>::Span
+SpscRing<T, N>::read_span()
+{
+    std::size_t tail   = _tail.load(MemoryOrder::RELAXED);
+    std::size_t used   = _head.load(MemoryOrder::ACQUIRE) - tail;
+    std::size_t offset = tail & MASK;
+    Span        span;
+
+    span.data = &_buffer[offset];
+    span.size = ((N - offset) < used) ? (N - offset) : used;
+
+    return span;
+}
+
+template <typename T, std::size_t N>
+inline
+void
+SpscRing<T, N>::commit_read(
+    std::size_t count
+)
+{
+    std::size_t tail = _tail.load(MemoryOrder::RELAXED);
+
+    CORE_ASSERT(count <= (_head.load(MemoryOrder::RELAXED) - tail));
+
+    _tail.store(tail + count, MemoryOrder::RELEASE);
+
+    if (has_notifier()) {
+        atomic_fence(MemoryOrder::SEQ_CST);
+    }
+}
+
+template <typename T, std::size_t N>
+template <core::os::CallingContext CTX>
+inline
+void
+SpscRing<T, N>::notify()
+{
+    SysLock::ScopeFrom<CTX> lock;
+    (void)lock;
+
+    if (_event != nullptr) {
+        _event->signal_unsafe(_event_index);
+    }
+
+    if (_semaphore != nullptr) {
+        _semaphore->signal_unsafe();
+    }
+}
+
+template <typename T, std::size_t N>
+inline
+bool
+SpscRing<T, N>::has_notifier() const
+{
+    return (_event != nullptr) || (_semaphore != nullptr);
+}
+
+template <typename T, std::size_t N>
+inline
+SpscRing<T, N>::SpscRing()
+    :
+    _head(0), _tail(0), _event(nullptr), _event_index(0), _semaphore(nullptr)
+{}
+
+
+NAMESPACE_CORE_OS_END
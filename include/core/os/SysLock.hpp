@@ -11,15 +11,49 @@
 
 #include <core/os/impl/SysLock_.hpp>
 
+#ifndef CORE_SYSLOCK_STATS
+#define CORE_SYSLOCK_STATS false
+#endif
+
+#ifndef CORE_SYSLOCK_STATS_SITES
+#define CORE_SYSLOCK_STATS_SITES 16
+#endif
+
+#if CORE_SYSLOCK_STATS
+#include <core/os/OS.hpp>
+#endif
+
 NAMESPACE_CORE_OS_BEGIN
 
 /*! \brief System lock
  *
  * When the system is in a locked state, the scheduler and the interrupts are disabled.
+ *
+ * When \c CORE_SYSLOCK_STATS is true every hold is timed with the realtime counter,
+ * and accounted to the code that acquired the lock (up to \c CORE_SYSLOCK_STATS_SITES call sites).
+ * Call sites are return addresses, to be resolved with addr2line; Scope must be inlined, so build with optimizations.
+ * The timing functions are defined out of line, in SysLock.cpp, which must be built with the same setting.
+ *
+ * A thread blocking inside a lock zone (e.g. Semaphore::wait_unsafe) lets other code run, so its hold is not timed,
+ * only counted in Stats::blocked. Such holds are detected when another hold starts or ends before they are released;
+ * to also catch the switches to code that does not take the lock, call SysLock::stats_context_switch
+ * from \c CH_CFG_CONTEXT_SWITCH_HOOK.
  */
 class SysLock:
     private core::Uncopyable
 {
+#if CORE_SYSLOCK_STATS
+public:
+    typedef OS::RealtimeCounter Cycles;
+
+private:
+    struct Hold {
+        const void* address;
+        Cycles      start;
+        uint32_t    sequence;
+    };
+#endif
+
 public:
     /*! \brief System lock [RAII]
      *
@@ -41,7 +75,11 @@ public:
          */
         Scope()
         {
+#if CORE_SYSLOCK_STATS
+            SysLock::acquire(_hold);
+#else
             SysLock::acquire();
+#endif
         }
 
         /*! \brief Release the system lock
@@ -49,8 +87,17 @@ public:
          */
         ~Scope()
         {
+#if CORE_SYSLOCK_STATS
+            SysLock::release(_hold);
+#else
             SysLock::release();
+#endif
         }
+
+#if CORE_SYSLOCK_STATS
+    private:
+        Hold _hold;
+#endif
     };
 
     /*! \brief System lock [RAII]
@@ -76,7 +123,11 @@ public:
          */
         ISRScope()
         {
+#if CORE_SYSLOCK_STATS
+            SysLock::acquire_from_isr(_hold);
+#else
             SysLock::acquire_from_isr();
+#endif
         }
 
         /*! \brief Release the system lock
@@ -84,8 +135,17 @@ public:
          */
         ~ISRScope()
         {
+#if CORE_SYSLOCK_STATS
+            SysLock::release_from_isr(_hold);
+#else
             SysLock::release_from_isr();
+#endif
         }
+
+#if CORE_SYSLOCK_STATS
+    private:
+        Hold _hold;
+#endif
     };
 
     /*! \brief System lock [RAII]
@@ -99,6 +159,25 @@ public:
      * } // release lock whenever lock goes out of scope
      * \endcode
      *
+     * Takes the lock as Scope for NORMAL and as ISRScope for ISR, and does nothing for SYSLOCK,
+     * so the \c *_unsafe calls in the scope are valid whatever \c CTX is.
+     * Generic code forwards its own \c CTX, rather than picking a context where it is called:
+     *
+     * \code{.cpp}
+     * template <core::os::CallingContext CTX>
+     * void
+     * Driver::complete(Request* request)
+     * {
+     *   {
+     *     core::os::SysLock::ScopeFrom<CTX> lock;
+     *     (void)lock;
+     *     _pending--;
+     *   }
+     *
+     *   _done.signal<CTX>();
+     * }
+     * \endcode
+     *
      * \tparam CTX calling context
      */
     template <core::os::CallingContext CTX>
@@ -140,9 +219,106 @@ public:
      */
     static void
     release_from_isr();
+
+
+#if CORE_SYSLOCK_STATS
+public:
+    /*! \brief Hold times of a call site
+     *
+     * Times are expressed in OS::RealtimeCounter units, the mean is \c total / \c count.
+     */
+    struct Site {
+        const void* address; //!< Return address of the acquire call, \c nullptr if the slot is unused
+        uint32_t    count; //!< Number of holds
+        uint64_t    total; //!< Sum of all the hold times
+        Cycles      max; //!< Longest hold
+    };
+
+    /*! \brief Hold times of all the call sites
+     *
+     */
+    struct Stats {
+        uint32_t    count; //!< Number of holds
+        uint64_t    total; //!< Sum of all the hold times
+        Cycles      max; //!< Longest hold
+        const void* max_address; //!< Call site of the longest hold
+        uint32_t    untracked; //!< Holds not accounted to a site because the table was full
+        uint32_t    blocked; //!< Holds not timed because the thread blocked inside the lock zone
+        Site        sites[CORE_SYSLOCK_STATS_SITES]; //!< Per call site statistics
+    };
+
+
+    /*! \brief Gets a consistent copy of the statistics
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    static void
+    get_stats(
+        Stats& stats //!< [out] statistics
+    );
+
+
+    /*! \brief Clears the statistics
+     *
+     * \warning Must be used only outside a system lock zone.
+     */
+    static void
+    reset_stats();
+
+
+    /*! \brief Notifies a context switch
+     *
+     * To be called from \c CH_CFG_CONTEXT_SWITCH_HOOK, so that holds interrupted by a switch are never timed.
+     */
+    static void
+    stats_context_switch();
+
+
+private:
+    struct State {
+        Stats    stats;
+        uint32_t sequence; // bumped by every acquire, release and context switch
+        Hold     raw; // hold of SysLock::acquire, which has no scope to keep it
+    };
+
+    static void
+    acquire(
+        Hold& hold
+    );
+
+    static void
+    release(
+        const Hold& hold
+    );
+
+    static void
+    acquire_from_isr(
+        Hold& hold
+    );
+
+    static void
+    release_from_isr(
+        const Hold& hold
+    );
+
+    static State&
+    state();
+
+    static void
+    stats_acquired(
+        Hold&       hold,
+        const void* address
+    );
+
+    static void
+    stats_released(
+        const Hold& hold
+    );
+#endif // if CORE_SYSLOCK_STATS
 };
 
 
+#if !CORE_SYSLOCK_STATS
 inline
 void
 SysLock::acquire()
@@ -170,6 +346,7 @@ SysLock::release_from_isr()
 {
     SysLock_::release_from_isr();
 }
+#endif // if !CORE_SYSLOCK_STATS
 
 template <>
 class SysLock::ScopeFrom<core::os::CallingContext::NORMAL> :
@@ -0,0 +1,184 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/common.hpp>
+#include <core/os/common.hpp>
+
+#include <core/os/Atomic.hpp>
+
+NAMESPACE_CORE_OS_BEGIN
+
+/*! \brief Triple buffer
+ *
+ * Hands large snapshots from a producer to a consumer without copies and without locks.
+ * The producer fills the back buffer in place and publishes it by swapping it with the middle one;
+ * the consumer swaps the middle buffer with its front one whenever a newer snapshot is available.
+ * Neither side ever waits for the other, and the consumer always sees the latest complete snapshot.
+ *
+ * \code{.cpp}
+ * core::os::TripleBuffer<Map> maps;
+ *
+ * // Producer (thread or ISR)
+ * build(maps.back());
+ * maps.publish();
+ *
+ * // Consumer
+ * const Map& map = maps.latest();
+ * \endcode
+ *
+ * \warning There must be a single producer and a single consumer.
+ *
+ * \tparam T snapshot type
+ */
+template <typename T>
+class TripleBuffer:
+    private core::Uncopyable
+{
+public:
+    /*! \brief Gets the buffer to be filled [producer]
+     *
+     * \note The buffer holds stale data: a whole snapshot must be written before publishing it.
+     */
+    T&
+    back();
+
+
+    /*! \brief Publishes the back buffer [producer]
+     */
+    void
+    publish();
+
+
+    /*! \brief Checks if a snapshot newer than the front buffer has been published
+     *
+     */
+    bool
+    has_update() const;
+
+
+    /*! \brief Moves the latest published snapshot to the front buffer [consumer]
+     *
+     * \return Success
+     * \retval false no new snapshot has been published, the front buffer is unchanged
+     */
+    bool
+    update();
+
+
+    /*! \brief Gets the snapshot in the front buffer [consumer]
+     *
+     * It stays valid until the next TripleBuffer::update.
+     */
+    const T&
+    front() const;
+
+
+    /*! \brief Gets the latest published snapshot [consumer]
+     *
+     * Shortcut for TripleBuffer::update followed by TripleBuffer::front.
+     */
+    const T&
+    latest();
+
+
+public:
+    TripleBuffer();
+    explicit
+    TripleBuffer(
+        const T& value //!< [in] initial value of all the buffers
+    );
+
+private:
+    enum : uint8_t {
+        INDEX_MASK = 0x03,
+        FRESH      = 0x04 // middle buffer has not been seen by the consumer yet
+    };
+
+private:
+    Atomic<uint8_t> _middle; // index of the middle buffer plus the FRESH flag
+    uint8_t _back; // producer only
+    uint8_t _front; // consumer only
+    T       _buffers[3];
+};
+
+
+template <typename T>
+inline
+T&
+TripleBuffer<T>::back()
+{
+    return _buffers[_back];
+}
+
+template <typename T>
+inline
+void
+TripleBuffer<T>::publish()
+{
+    _back = _middle.exchange(_back | FRESH, MemoryOrder::ACQ_REL) & INDEX_MASK;
+}
+
+template <typename T>
+inline
+bool
+TripleBuffer<T>::has_update() const
+{
+    return (_middle.load(MemoryOrder::RELAXED) & FRESH) != 0;
+}
+
+template <typename T>
+inline
+bool
+TripleBuffer<T>::update()
+{
+    if (!has_update()) {
+        return false;
+    }
+
+    _front = _middle.exchange(_front, MemoryOrder::ACQ_REL) & INDEX_MASK;
+
+    return true;
+}
+
+template <typename T>
+inline
+const T&
+TripleBuffer<T>::front() const
+{
+    return _buffers[_front];
+}
+
+template <typename T>
+inline
+const T&
+TripleBuffer<T>::latest()
+{
+    update();
+
+    return front();
+}
+
+template <typename T>
+inline
+TripleBuffer<T>::TripleBuffer()
+    :
+    _middle(1), _back(0), _front(2), _buffers()
+{}
+
+
+template <typename T>
+inline
+TripleBuffer<T>::TripleBuffer(
+    const T& value
+)
+    :
+    _middle(1), _back(0), _front(2), _buffers{value, value, value}
+{}
+
+
+NAMESPACE_CORE_OS_END
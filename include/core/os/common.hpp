@@ -12,7 +12,14 @@ NAMESPACE_CORE_OS_BEGIN
 
 /*! \brief CallingContext
  *
- * \todo This has to be explained quite well
+ * Where a piece of code runs, and so which kind of locking it needs:
+ * - NORMAL: a thread, outside a system lock zone. Blocking calls are allowed.
+ * - ISR: an interrupt service routine. The system lock must be taken with the ISR variant, blocking calls are forbidden.
+ * - SYSLOCK: any context, with the system lock already held. Only the \c *_unsafe (I-class and S-class) calls can be used.
+ *
+ * Primitives offer methods templated on the context (e.g. Semaphore::signal<CTX>), that compile to the minimal locking:
+ * generic code written once for all the contexts takes \c CTX as a template parameter and forwards it, instead of
+ * being duplicated or taking the system lock twice. Methods that can block do not accept ISR.
  */
 enum class CallingContext {
     NORMAL, //!< Normal (thread)
@@ -20,4 +27,16 @@ enum class CallingContext {
     SYSLOCK //!< Syslocked
 };
 
+/*! \brief Memory ordering of atomic operations
+ *
+ * Same meaning as the std::memory_order values with the same name.
+ */
+enum class MemoryOrder {
+    RELAXED, //!< No ordering, atomicity only
+    ACQUIRE, //!< Later accesses are not moved before the operation
+    RELEASE, //!< Earlier accesses are not moved after the operation
+    ACQ_REL, //!< Both ACQUIRE and RELEASE
+    SEQ_CST //!< ACQ_REL plus a single total order of all SEQ_CST operations
+};
+
 NAMESPACE_CORE_OS_END
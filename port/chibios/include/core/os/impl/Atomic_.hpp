@@ -0,0 +1,385 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/os/namespace.hpp>
+#include <core/common.hpp>
+#include <core/os/common.hpp>
+#include <ch.h>
+
+#include <type_traits>
+
+// Cortex-M3 and above have exclusive load/store, so GCC inlines LDREX/STREX loops for the read-modify-write builtins.
+// Cortex-M0 has not: read-modify-write operations fall back to a critical section.
+#if (__GCC_ATOMIC_CHAR_LOCK_FREE == 2) && (__GCC_ATOMIC_SHORT_LOCK_FREE == 2) && \
+    (__GCC_ATOMIC_INT_LOCK_FREE == 2) && (__GCC_ATOMIC_POINTER_LOCK_FREE == 2)
+#define CORE_ATOMIC_LOCK_FREE_ true
+#else
+#define CORE_ATOMIC_LOCK_FREE_ false
+#endif
+
+NAMESPACE_CORE_OS_BEGIN
+
+
+class AtomicOrder_
+{
+public:
+    static int
+    to_builtin(
+        MemoryOrder order
+    );
+
+    static int
+    to_builtin_failure(
+        MemoryOrder order
+    );
+
+    static void
+    fence(
+        MemoryOrder order
+    );
+};
+
+
+template <typename T>
+class Atomic_:
+    private core::Uncopyable
+{
+    static_assert(std::is_integral<T>::value || std::is_pointer<T>::value || std::is_enum<T>::value,
+                  "Atomic_ supports integral, enum and pointer types only");
+    static_assert(sizeof(T) <= sizeof(void*), "Atomic_ supports up to word sized types");
+
+public:
+    T
+    load(
+        MemoryOrder order
+    ) const;
+
+    void
+    store(
+        T           value,
+        MemoryOrder order
+    );
+
+    T
+    exchange(
+        T           value,
+        MemoryOrder order
+    );
+
+    bool
+    compare_exchange(
+        T&          expected,
+        T           desired,
+        MemoryOrder order
+    );
+
+    T
+    fetch_add(
+        T           operand,
+        MemoryOrder order
+    );
+
+    T
+    fetch_sub(
+        T           operand,
+        MemoryOrder order
+    );
+
+    T
+    fetch_and(
+        T           operand,
+        MemoryOrder order
+    );
+
+    T
+    fetch_or(
+        T           operand,
+        MemoryOrder order
+    );
+
+    T
+    fetch_xor(
+        T           operand,
+        MemoryOrder order
+    );
+
+
+public:
+    Atomic_(
+        T value
+    );
+
+private:
+#if !CORE_ATOMIC_LOCK_FREE_
+    template <typename Operation>
+    T
+    locked_update(
+        Operation operation
+    );
+#endif
+
+private:
+    T _value;
+};
+
+
+inline
+int
+AtomicOrder_::to_builtin(
+    MemoryOrder order
+)
+{
+    switch (order) {
+      case MemoryOrder::RELAXED:
+          return __ATOMIC_RELAXED;
+
+      case MemoryOrder::ACQUIRE:
+          return __ATOMIC_ACQUIRE;
+
+      case MemoryOrder::RELEASE:
+          return __ATOMIC_RELEASE;
+
+      case MemoryOrder::ACQ_REL:
+          return __ATOMIC_ACQ_REL;
+
+      default:
+          return __ATOMIC_SEQ_CST;
+    }
+}
+
+inline
+int
+AtomicOrder_::to_builtin_failure(
+    MemoryOrder order
+)
+{
+    // A failed compare-exchange is a load: it cannot have release semantics.
+    switch (order) {
+      case MemoryOrder::RELEASE:
+          return __ATOMIC_RELAXED;
+
+      case MemoryOrder::ACQ_REL:
+          return __ATOMIC_ACQUIRE;
+
+      default:
+          return to_builtin(order);
+    }
+}
+
+inline
+void
+AtomicOrder_::fence(
+    MemoryOrder order
+)
+{
+    __atomic_thread_fence(to_builtin(order));
+}
+
+template <typename T>
+inline
+T
+Atomic_<T>::load(
+    MemoryOrder order
+) const
+{
+    return __atomic_load_n(&_value, AtomicOrder_::to_builtin(order));
+}
+
+template <typename T>
+inline
+void
+Atomic_<T>::store(
+    T           value,
+    MemoryOrder order
+)
+{
+    __atomic_store_n(&_value, value, AtomicOrder_::to_builtin(order));
+}
+
+template <typename T>
+inline
+T
+Atomic_<T>::exchange(
+    T           value,
+    MemoryOrder order
+)
+{
+#if CORE_ATOMIC_LOCK_FREE_
+    return __atomic_exchange_n(&_value, value, AtomicOrder_::to_builtin(order));
+
+#else
+    (void)order;
+    return locked_update([value](T) {
+        return value;
+    });
+#endif
+}
+
+template <typename T>
+inline
+bool
+Atomic_<T>::compare_exchange(
+    T&          expected,
+    T           desired,
+    MemoryOrder order
+)
+{
+#if CORE_ATOMIC_LOCK_FREE_
+    return __atomic_compare_exchange_n(&_value, &expected, desired, false,
+                                       AtomicOrder_::to_builtin(order), AtomicOrder_::to_builtin_failure(order));
+
+#else
+    (void)order;
+    T previous = locked_update([expected, desired](T value) {
+        return (value == expected) ? desired : value;
+    });
+
+    if (previous != expected) {
+        expected = previous;
+        return false;
+    }
+
+    return true;
+#endif
+} // compare_exchange
+
+template <typename T>
+inline
+T
+Atomic_<T>::fetch_add(
+    T           operand,
+    MemoryOrder order
+)
+{
+    static_assert(std::is_integral<T>::value, "Arithmetic is supported on integral types only");
+
+#if CORE_ATOMIC_LOCK_FREE_
+    return __atomic_fetch_add(&_value, operand, AtomicOrder_::to_builtin(order));
+
+#else
+    (void)order;
+    return locked_update([operand](T value) {
+        return static_cast<T>(value + operand);
+    });
+#endif
+}
+
+template <typename T>
+inline
+T
+Atomic_<T>::fetch_sub(
+    T           operand,
+    MemoryOrder order
+)
+{
+    static_assert(std::is_integral<T>::value, "Arithmetic is supported on integral types only");
+
+#if CORE_ATOMIC_LOCK_FREE_
+    return __atomic_fetch_sub(&_value, operand, AtomicOrder_::to_builtin(order));
+
+#else
+    (void)order;
+    return locked_update([operand](T value) {
+        return static_cast<T>(value - operand);
+    });
+#endif
+}
+
+template <typename T>
+inline
+T
+Atomic_<T>::fetch_and(
+    T           operand,
+    MemoryOrder order
+)
+{
+    static_assert(std::is_integral<T>::value, "Bitwise operations are supported on integral types only");
+
+#if CORE_ATOMIC_LOCK_FREE_
+    return __atomic_fetch_and(&_value, operand, AtomicOrder_::to_builtin(order));
+
+#else
+    (void)order;
+    return locked_update([operand](T value) {
+        return static_cast<T>(value & operand);
+    });
+#endif
+}
+
+template <typename T>
+inline
+T
+Atomic_<T>::fetch_or(
+    T           operand,
+    MemoryOrder order
+)
+{
+    static_assert(std::is_integral<T>::value, "Bitwise operations are supported on integral types only");
+
+#if CORE_ATOMIC_LOCK_FREE_
+    return __atomic_fetch_or(&_value, operand, AtomicOrder_::to_builtin(order));
+
+#else
+    (void)order;
+    return locked_update([operand](T value) {
+        return static_cast<T>(value | operand);
+    });
+#endif
+}
+
+template <typename T>
+inline
+T
+Atomic_<T>::fetch_xor(
+    T           operand,
+    MemoryOrder order
+)
+{
+    static_assert(std::is_integral<T>::value, "Bitwise operations are supported on integral types only");
+
+#if CORE_ATOMIC_LOCK_FREE_
+    return __atomic_fetch_xor(&_value, operand, AtomicOrder_::to_builtin(order));
+
+#else
+    (void)order;
+    return locked_update([operand](T value) {
+        return static_cast<T>(value ^ operand);
+    });
+#endif
+}
+
+#if !CORE_ATOMIC_LOCK_FREE_
+template <typename T>
+template <typename Operation>
+inline
+T
+Atomic_<T>::locked_update(
+    Operation operation
+)
+{
+    // Usable from any context, also from within a system lock zone.
+    syssts_t status   = chSysGetStatusAndLockX();
+    T        previous = _value;
+
+    _value = operation(previous);
+    chSysRestoreStatusX(status);
+
+    return previous;
+}
+#endif
+
+template <typename T>
+inline
+Atomic_<T>::Atomic_(
+    T value
+)
+    :
+    _value(value)
+{}
+
+NAMESPACE_CORE_OS_END
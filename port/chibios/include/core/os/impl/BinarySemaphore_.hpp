@@ -0,0 +1,184 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/os/namespace.hpp>
+#include <core/common.hpp>
+#include <core/os/Time.hpp>
+#include <ch.h>
+
+NAMESPACE_CORE_OS_BEGIN
+
+
+class BinarySemaphore_:
+    private core::Uncopyable
+{
+private:
+    ::binary_semaphore_t impl;
+
+public:
+    void
+    initialize(
+        bool taken = true
+    );
+
+    void
+    reset_unsafe(
+        bool taken = true
+    );
+
+    void
+    signal_unsafe();
+
+    void
+    wait_unsafe();
+
+    bool
+    wait_unsafe(
+        const Time& timeout
+    );
+
+    bool
+    is_taken_unsafe();
+
+    void
+    reset(
+        bool taken = true
+    );
+
+    void
+    signal();
+
+    void
+    wait();
+
+    bool
+    wait(
+        const Time& timeout
+    );
+
+    bool
+    is_taken();
+
+
+    ::binary_semaphore_t & get_impl();
+
+public:
+    BinarySemaphore_(
+        bool taken = true
+    );
+};
+
+
+inline
+void
+BinarySemaphore_::initialize(
+    bool taken
+)
+{
+    chBSemObjectInit(&impl, taken);
+}
+
+inline
+void
+BinarySemaphore_::reset_unsafe(
+    bool taken
+)
+{
+    chBSemResetI(&impl, taken);
+}
+
+inline
+void
+BinarySemaphore_::signal_unsafe()
+{
+    chBSemSignalI(&impl);
+}
+
+inline
+void
+BinarySemaphore_::wait_unsafe()
+{
+    chBSemWaitS(&impl);
+}
+
+inline
+bool
+BinarySemaphore_::wait_unsafe(
+    const Time& timeout
+)
+{
+    return chBSemWaitTimeoutS(&impl, timeout.ticks()) == MSG_OK;
+}
+
+inline
+bool
+BinarySemaphore_::is_taken_unsafe()
+{
+    return chBSemGetStateI(&impl);
+}
+
+inline
+void
+BinarySemaphore_::reset(
+    bool taken
+)
+{
+    chBSemReset(&impl, taken);
+}
+
+inline
+void
+BinarySemaphore_::signal()
+{
+    chBSemSignal(&impl);
+}
+
+inline
+void
+BinarySemaphore_::wait()
+{
+    chBSemWait(&impl);
+}
+
+inline
+bool
+BinarySemaphore_::wait(
+    const Time& timeout
+)
+{
+    return chBSemWaitTimeout(&impl, timeout.ticks()) == MSG_OK;
+}
+
+inline
+bool
+BinarySemaphore_::is_taken()
+{
+    bool taken;
+
+    chSysLock();
+    taken = chBSemGetStateI(&impl);
+    chSysUnlock();
+
+    return taken;
+}
+
+inline
+  ::binary_semaphore_t& BinarySemaphore_::get_impl() {
+    return impl;
+}
+
+
+inline
+BinarySemaphore_::BinarySemaphore_(
+    bool taken
+)
+{
+    initialize(taken);
+}
+
+NAMESPACE_CORE_OS_END
@@ -0,0 +1,111 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/os/namespace.hpp>
+#include <core/common.hpp>
+#include <core/os/Time.hpp>
+#include <core/os/impl/Semaphore_.hpp>
+#include <core/os/impl/Thread_.hpp>
+#include <ch.h>
+
+NAMESPACE_CORE_OS_BEGIN
+
+
+class CeilingMutex_:
+    private core::Uncopyable
+{
+public:
+    typedef Thread_::Priority Priority;
+
+private:
+    Semaphore_ lock;
+    Priority   ceiling;
+    Priority   saved;
+
+public:
+    Priority
+    get_ceiling() const;
+
+    void
+    acquire();
+
+    bool
+    try_acquire();
+
+    void
+    release();
+
+
+public:
+    CeilingMutex_(
+        Priority ceiling
+    );
+};
+
+
+inline
+CeilingMutex_::Priority
+CeilingMutex_::get_ceiling() const
+{
+    return ceiling;
+}
+
+inline
+void
+CeilingMutex_::acquire()
+{
+    // Once at the ceiling no other user of the mutex can preempt us: the wait blocks only if the owner
+    // blocked while holding the mutex.
+    Priority previous = chThdSetPriority(ceiling);
+
+    CORE_ASSERT(previous <= ceiling);
+
+    lock.wait();
+    saved = previous;
+}
+
+inline
+bool
+CeilingMutex_::try_acquire()
+{
+    Priority previous = chThdSetPriority(ceiling);
+
+    CORE_ASSERT(previous <= ceiling);
+
+    if (!lock.wait(Time::IMMEDIATE)) {
+        chThdSetPriority(previous);
+        return false;
+    }
+
+    saved = previous;
+    return true;
+}
+
+inline
+void
+CeilingMutex_::release()
+{
+    Priority previous = saved;
+
+    lock.signal();
+
+    // Lowering the priority reschedules, a waiting user of the mutex runs now.
+    chThdSetPriority(previous);
+}
+
+inline
+CeilingMutex_::CeilingMutex_(
+    Priority ceiling
+)
+    :
+    lock(static_cast<Semaphore_::Count>(1)),
+    ceiling(ceiling),
+    saved(ceiling)
+{}
+
+NAMESPACE_CORE_OS_END
@@ -0,0 +1,282 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/os/namespace.hpp>
+#include <core/common.hpp>
+#include <core/os/Time.hpp>
+#include <core/os/Thread.hpp>
+#include <core/os/impl/SpinEvent_.hpp>
+#include <ch.h>
+
+NAMESPACE_CORE_OS_BEGIN
+
+
+class CoalescingSpinEvent_:
+    private core::Uncopyable
+{
+public:
+    typedef SpinEvent_::Mask Mask;
+
+private:
+    typedef ::thread_t ChThread;
+
+private:
+    Thread*  threadp;
+    Mask     pending;
+    uint32_t count;
+    uint32_t threshold;
+    systime_t window;
+    ::virtual_timer_t timer;
+    uint32_t coalesced;
+    uint32_t delivered;
+
+public:
+    Thread*
+    get_thread() const;
+
+    void
+    set_thread(
+        Thread* threadp
+    );
+
+    void
+    set_window(
+        const Time& window
+    );
+
+    void
+    set_threshold(
+        uint32_t threshold
+    );
+
+    void
+    signal_unsafe(
+        unsigned event_index
+    );
+
+    void
+    signal(
+        unsigned event_index
+    );
+
+    void
+    flush_unsafe();
+
+    void
+    flush();
+
+    Mask
+    wait(
+        const Time& timeout
+    );
+
+    uint32_t
+    get_coalesced() const;
+
+    uint32_t
+    get_delivered() const;
+
+    void
+    reset_stats();
+
+
+public:
+    CoalescingSpinEvent_(
+        const Time& window,
+        uint32_t    threshold,
+        Thread*     threadp = & Thread::self()
+    );
+
+    ~CoalescingSpinEvent_();
+
+private:
+    static void
+    timer_callback(
+        void* objp
+    );
+};
+
+
+inline
+Thread*
+CoalescingSpinEvent_::get_thread() const
+{
+    return threadp;
+}
+
+inline
+void
+CoalescingSpinEvent_::set_thread(
+    Thread* threadp
+)
+{
+    this->threadp = threadp;
+}
+
+inline
+void
+CoalescingSpinEvent_::set_window(
+    const Time& window
+)
+{
+    CORE_ASSERT(window.ticks() != TIME_IMMEDIATE);
+    CORE_ASSERT(window.ticks() != TIME_INFINITE);
+
+    this->window = window.ticks();
+}
+
+inline
+void
+CoalescingSpinEvent_::set_threshold(
+    uint32_t threshold
+)
+{
+    CORE_ASSERT(threshold > 0);
+
+    this->threshold = threshold;
+}
+
+inline
+void
+CoalescingSpinEvent_::signal_unsafe(
+    unsigned event_index
+)
+{
+    if (threadp != NULL) {
+        CORE_ASSERT(event_index < 8 * sizeof(Mask));
+
+        pending |= static_cast<Mask>(1) << event_index;
+        count++;
+
+        if (count >= threshold) {
+            flush_unsafe();
+        } else if (!chVTIsArmedI(&timer)) {
+            // First signal of a burst: deliver at the latest when the window expires.
+            chVTSetI(&timer, window, timer_callback, this);
+        }
+    }
+}
+
+inline
+void
+CoalescingSpinEvent_::signal(
+    unsigned event_index
+)
+{
+    chSysLock();
+    signal_unsafe(event_index);
+    chSchRescheduleS();
+    chSysUnlock();
+}
+
+inline
+void
+CoalescingSpinEvent_::flush_unsafe()
+{
+    if (chVTIsArmedI(&timer)) {
+        chVTResetI(&timer);
+    }
+
+    if ((pending != 0) && (threadp != NULL)) {
+        chEvtSignalI(reinterpret_cast<ChThread*>(threadp), pending);
+        coalesced += count - 1;
+        delivered++;
+    }
+
+    pending = 0;
+    count   = 0;
+}
+
+inline
+void
+CoalescingSpinEvent_::flush()
+{
+    chSysLock();
+    flush_unsafe();
+    chSchRescheduleS();
+    chSysUnlock();
+}
+
+inline
+CoalescingSpinEvent_::Mask
+CoalescingSpinEvent_::wait(
+    const Time& timeout
+)
+{
+    return chEvtWaitAnyTimeout(ALL_EVENTS, timeout.ticks());
+}
+
+inline
+uint32_t
+CoalescingSpinEvent_::get_coalesced() const
+{
+    return coalesced;
+}
+
+inline
+uint32_t
+CoalescingSpinEvent_::get_delivered() const
+{
+    return delivered;
+}
+
+inline
+void
+CoalescingSpinEvent_::reset_stats()
+{
+    chSysLock();
+    coalesced = 0;
+    delivered = 0;
+    chSysUnlock();
+}
+
+inline
+void
+CoalescingSpinEvent_::timer_callback(
+    void* objp
+)
+{
+    chSysLockFromISR();
+    reinterpret_cast<CoalescingSpinEvent_*>(objp)->flush_unsafe();
+    chSysUnlockFromISR();
+}
+
+inline
+CoalescingSpinEvent_::CoalescingSpinEvent_(
+    const Time& window,
+    uint32_t    threshold,
+    Thread*     threadp
+)
+    :
+    threadp(threadp),
+    pending(0),
+    count(0),
+    threshold(1),
+    window(1),
+    coalesced(0),
+    delivered(0)
+{
+    chVTObjectInit(&timer);
+    set_window(window);
+    set_threshold(threshold);
+}
+
+inline
+CoalescingSpinEvent_::~CoalescingSpinEvent_()
+{
+    // The timer must not stay linked in the kernel list once the object is gone.
+    chSysLock();
+
+    if (chVTIsArmedI(&timer)) {
+        chVTResetI(&timer);
+    }
+
+    chSysUnlock();
+}
+
+NAMESPACE_CORE_OS_END
@@ -18,7 +18,8 @@ class Condition_:
     private core::Uncopyable
 {
 private:
-    ::condition_variable_t impl;
+    ::condition_variable_t impl; // untimed waiters, they can be moved to a mutex queue
+    ::condition_variable_t timed; // timed waiters, their timeout is armed until they are woken up
 
 public:
     void
@@ -30,6 +31,14 @@ public:
     void
     broadcast_unsafe();
 
+    void
+    broadcast_requeue_unsafe();
+
+    void
+    notify_n_unsafe(
+        unsigned count
+    );
+
     void
     wait_unsafe();
 
@@ -44,6 +53,14 @@ public:
     void
     broadcast();
 
+    void
+    broadcast_requeue();
+
+    void
+    notify_n(
+        unsigned count
+    );
+
     void
     wait();
 
@@ -61,6 +78,15 @@ public:
     Condition_(
         bool initialize
     );
+
+private:
+    bool
+    signal_one_unsafe();
+
+    static ::thread_t*
+    head(
+        ::threads_queue_t& queue
+    );
 };
 
 
@@ -69,13 +95,14 @@ void
 Condition_::initialize()
 {
     chCondObjectInit(&impl);
+    chCondObjectInit(&timed);
 }
 
 inline
 void
 Condition_::signal_unsafe()
 {
-    chCondSignalI(&impl);
+    (void)signal_one_unsafe();
 }
 
 inline
@@ -83,13 +110,71 @@ void
 Condition_::broadcast_unsafe()
 {
     chCondBroadcastI(&impl);
+    chCondBroadcastI(&timed);
+}
+
+inline
+void
+Condition_::broadcast_requeue_unsafe()
+{
+    ::thread_t* self = chThdGetSelfX();
+    ::mutex_t*  mp   = chMtxGetNextMutexS();
+
+    // Timed waiters cannot wait on a mutex: their timeout would wake them up from its queue.
+    chCondBroadcastI(&timed);
+
+    if (mp == NULL) {
+        chCondBroadcastI(&impl);
+        return;
+    }
+
+    CORE_ASSERT(mp->m_owner == self);
+
+    // Untimed waiters go straight to the mutex queue, as if they had been woken up and had called chMtxLockS:
+    // each release hands the mutex over to one of them, and Condition_::wait_unsafe does not lock it again.
+    while (queue_notempty(&impl.c_queue)) {
+        ::thread_t* tp = queue_fifo_remove(&impl.c_queue);
+
+        tp->p_state    = CH_STATE_WTMTX;
+        tp->p_u.wtmtxp = mp;
+        queue_prio_insert(tp, &mp->m_queue);
+
+        // Priority inheritance, the caller owns the mutex and is running: nothing further to walk.
+        if (self->p_prio < tp->p_prio) {
+            self->p_prio = tp->p_prio;
+        }
+    }
+} // broadcast_requeue_unsafe
+
+inline
+void
+Condition_::notify_n_unsafe(
+    unsigned count
+)
+{
+    while ((count > 0) && signal_one_unsafe()) {
+        count--;
+    }
 }
 
 inline
 void
 Condition_::wait_unsafe()
 {
-    chCondWaitS(&impl);
+    // Same as chCondWaitS, but the mutex may have been handed over by Condition_::broadcast_requeue_unsafe.
+    ::thread_t* self = chThdGetSelfX();
+    ::mutex_t*  mp   = chMtxGetNextMutexS();
+
+    CORE_ASSERT(mp != NULL);
+
+    chMtxUnlockS(mp);
+    self->p_u.wtobjp = &impl;
+    queue_prio_insert(self, &impl.c_queue);
+    chSchGoSleepS(CH_STATE_WTCOND);
+
+    if (mp->m_owner != self) {
+        chMtxLockS(mp);
+    }
 }
 
 inline
@@ -98,28 +183,63 @@ Condition_::wait_unsafe(
     const Time& timeout
 )
 {
-    return chCondWaitTimeoutS(&impl, timeout.ticks()) != MSG_TIMEOUT;
+    if (timeout.ticks() == TIME_INFINITE) {
+        wait_unsafe();
+        return true;
+    }
+
+    return chCondWaitTimeoutS(&timed, timeout.ticks()) != MSG_TIMEOUT;
 }
 
 inline
 void
 Condition_::signal()
 {
-    chCondSignal(&impl);
+    chSysLock();
+    signal_unsafe();
+    chSchRescheduleS();
+    chSysUnlock();
 }
 
 inline
 void
 Condition_::broadcast()
 {
-    chCondBroadcast(&impl);
+    chSysLock();
+    broadcast_unsafe();
+    chSchRescheduleS();
+    chSysUnlock();
+}
+
+inline
+void
+Condition_::broadcast_requeue()
+{
+    chSysLock();
+    broadcast_requeue_unsafe();
+    chSchRescheduleS();
+    chSysUnlock();
+}
+
+inline
+void
+Condition_::notify_n(
+    unsigned count
+)
+{
+    chSysLock();
+    notify_n_unsafe(count);
+    chSchRescheduleS();
+    chSysUnlock();
 }
 
 inline
 void
 Condition_::wait()
 {
-    chCondWait(&impl);
+    chSysLock();
+    wait_unsafe();
+    chSysUnlock();
 }
 
 inline
@@ -128,7 +248,42 @@ Condition_::wait(
     const Time& timeout
 )
 {
-    return chCondWaitTimeout(&impl, timeout.ticks()) == MSG_OK;
+    if (timeout.ticks() == TIME_INFINITE) {
+        wait();
+        return true;
+    }
+
+    return chCondWaitTimeout(&timed, timeout.ticks()) == MSG_OK;
+}
+
+inline
+bool
+Condition_::signal_one_unsafe()
+{
+    // Both queues are ordered by priority, wake up the highest priority head.
+    ::thread_t* untimed    = head(impl.c_queue);
+    ::thread_t* timed_head = head(timed.c_queue);
+
+    if ((untimed != NULL) && ((timed_head == NULL) || (untimed->p_prio >= timed_head->p_prio))) {
+        chCondSignalI(&impl);
+        return true;
+    }
+
+    if (timed_head != NULL) {
+        chCondSignalI(&timed);
+        return true;
+    }
+
+    return false;
+}
+
+inline
+::thread_t*
+Condition_::head(
+    ::threads_queue_t& queue
+)
+{
+    return queue_isempty(&queue) ? NULL : queue.p_next;
 }
 
 inline
@@ -0,0 +1,299 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/os/namespace.hpp>
+#include <core/common.hpp>
+#include <core/os/Time.hpp>
+#include <ch.h>
+
+NAMESPACE_CORE_OS_BEGIN
+
+
+class EventGroup_:
+    private core::Uncopyable
+{
+public:
+    typedef ::eventflags_t Mask;
+
+private:
+    struct Waiter {
+        Waiter*              next;
+        ::thread_reference_t thread;
+        ::tprio_t prio;
+        Mask mask;
+        bool all;
+        Mask result;
+    };
+
+private:
+    Mask    flags;
+    Waiter* waiters; // by decreasing priority, FIFO among equals
+
+public:
+    void
+    initialize(
+        Mask value = 0
+    );
+
+    Mask
+    get() const;
+
+    void
+    set_unsafe(
+        Mask mask
+    );
+
+    void
+    clear_unsafe(
+        Mask mask
+    );
+
+    Mask
+    wait_any_unsafe(
+        Mask        mask,
+        const Time& timeout
+    );
+
+    Mask
+    wait_all_unsafe(
+        Mask        mask,
+        const Time& timeout
+    );
+
+    void
+    set(
+        Mask mask
+    );
+
+    void
+    clear(
+        Mask mask
+    );
+
+    Mask
+    wait_any(
+        Mask        mask,
+        const Time& timeout
+    );
+
+    Mask
+    wait_all(
+        Mask        mask,
+        const Time& timeout
+    );
+
+
+public:
+    EventGroup_(
+        Mask value = 0
+    );
+
+private:
+    Mask
+    wait_unsafe(
+        Mask        mask,
+        bool        all,
+        const Time& timeout
+    );
+
+    static bool
+    is_satisfied(
+        Mask value,
+        Mask mask,
+        bool all
+    );
+};
+
+
+inline
+void
+EventGroup_::initialize(
+    Mask value
+)
+{
+    flags   = value;
+    waiters = NULL;
+}
+
+inline
+EventGroup_::Mask
+EventGroup_::get() const
+{
+    return flags;
+}
+
+inline
+void
+EventGroup_::set_unsafe(
+    Mask mask
+)
+{
+    Waiter** link = &waiters;
+
+    flags |= mask;
+
+    // Wake up only the waiters whose condition is now true, all the others stay queued.
+    while (*link != NULL) {
+        Waiter* waiterp = *link;
+
+        if (is_satisfied(flags, waiterp->mask, waiterp->all)) {
+            *link = waiterp->next;
+            waiterp->result = flags & waiterp->mask;
+            chThdResumeI(&waiterp->thread, MSG_OK);
+        } else {
+            link = &waiterp->next;
+        }
+    }
+}
+
+inline
+void
+EventGroup_::clear_unsafe(
+    Mask mask
+)
+{
+    flags &= ~mask;
+}
+
+inline
+EventGroup_::Mask
+EventGroup_::wait_any_unsafe(
+    Mask        mask,
+    const Time& timeout
+)
+{
+    return wait_unsafe(mask, false, timeout);
+}
+
+inline
+EventGroup_::Mask
+EventGroup_::wait_all_unsafe(
+    Mask        mask,
+    const Time& timeout
+)
+{
+    return wait_unsafe(mask, true, timeout);
+}
+
+inline
+void
+EventGroup_::set(
+    Mask mask
+)
+{
+    chSysLock();
+    set_unsafe(mask);
+    chSchRescheduleS();
+    chSysUnlock();
+}
+
+inline
+void
+EventGroup_::clear(
+    Mask mask
+)
+{
+    chSysLock();
+    clear_unsafe(mask);
+    chSysUnlock();
+}
+
+inline
+EventGroup_::Mask
+EventGroup_::wait_any(
+    Mask        mask,
+    const Time& timeout
+)
+{
+    Mask result;
+
+    chSysLock();
+    result = wait_unsafe(mask, false, timeout);
+    chSysUnlock();
+
+    return result;
+}
+
+inline
+EventGroup_::Mask
+EventGroup_::wait_all(
+    Mask        mask,
+    const Time& timeout
+)
+{
+    Mask result;
+
+    chSysLock();
+    result = wait_unsafe(mask, true, timeout);
+    chSysUnlock();
+
+    return result;
+}
+
+inline
+EventGroup_::Mask
+EventGroup_::wait_unsafe(
+    Mask        mask,
+    bool        all,
+    const Time& timeout
+)
+{
+    Waiter   waiter;
+    Waiter** link;
+
+    CORE_ASSERT(mask != 0);
+
+    if (is_satisfied(flags, mask, all)) {
+        return flags & mask;
+    }
+
+    waiter.thread = NULL;
+    waiter.prio   = chThdGetSelfX()->p_prio;
+    waiter.mask   = mask;
+    waiter.all    = all;
+    waiter.result = 0;
+
+    // Same ordering as queue_prio_insert, so that set_unsafe wakes up the waiters as the other ChibiOS queues do.
+    for (link = &waiters; (*link != NULL) && ((*link)->prio >= waiter.prio); link = &(*link)->next) {}
+
+    waiter.next = *link;
+    *link       = &waiter;
+
+    if (chThdSuspendTimeoutS(&waiter.thread, timeout.ticks()) == MSG_TIMEOUT) {
+        // Timed out, still queued.
+        for (link = &waiters; *link != NULL; link = &(*link)->next) {
+            if (*link == &waiter) {
+                *link = waiter.next;
+                break;
+            }
+        }
+    }
+
+    return waiter.result;
+} // wait_unsafe
+
+inline
+bool
+EventGroup_::is_satisfied(
+    Mask value,
+    Mask mask,
+    bool all
+)
+{
+    return all ? ((value & mask) == mask) : ((value & mask) != 0);
+}
+
+inline
+EventGroup_::EventGroup_(
+    Mask value
+)
+{
+    initialize(value);
+}
+
+NAMESPACE_CORE_OS_END
@@ -0,0 +1,125 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/os/namespace.hpp>
+#include <core/common.hpp>
+#include <core/os/impl/EventSource_.hpp>
+#include <ch.h>
+
+NAMESPACE_CORE_OS_BEGIN
+
+
+class EventListener_:
+    private core::Uncopyable
+{
+public:
+    typedef EventSource_::Flags Flags;
+    typedef ::eventmask_t       Mask;
+
+private:
+    ::event_listener_t impl;
+    EventSource_*      sourcep;
+
+public:
+    void
+    attach(
+        EventSource_& source,
+        unsigned      event_index,
+        Flags         flags
+    );
+
+    void
+    detach();
+
+    bool
+    is_attached() const;
+
+    Mask
+    get_mask() const;
+
+    Flags
+    get_and_clear_flags_unsafe();
+
+    Flags
+    get_and_clear_flags();
+
+
+public:
+    EventListener_();
+    ~EventListener_();
+};
+
+
+inline
+void
+EventListener_::attach(
+    EventSource_& source,
+    unsigned      event_index,
+    Flags         flags
+)
+{
+    CORE_ASSERT(sourcep == NULL);
+    CORE_ASSERT(event_index < 8 * sizeof(Mask));
+
+    chEvtRegisterMaskWithFlags(&source.get_impl(), &impl, EVENT_MASK(event_index), flags);
+    sourcep = &source;
+}
+
+inline
+void
+EventListener_::detach()
+{
+    if (sourcep != NULL) {
+        chEvtUnregister(&sourcep->get_impl(), &impl);
+        sourcep = NULL;
+    }
+}
+
+inline
+bool
+EventListener_::is_attached() const
+{
+    return sourcep != NULL;
+}
+
+inline
+EventListener_::Mask
+EventListener_::get_mask() const
+{
+    return impl.el_events;
+}
+
+inline
+EventListener_::Flags
+EventListener_::get_and_clear_flags_unsafe()
+{
+    return chEvtGetAndClearFlagsI(&impl);
+}
+
+inline
+EventListener_::Flags
+EventListener_::get_and_clear_flags()
+{
+    return chEvtGetAndClearFlags(&impl);
+}
+
+inline
+EventListener_::EventListener_()
+    :
+    sourcep(NULL)
+{
+    impl.el_events = 0;
+}
+
+inline
+EventListener_::~EventListener_()
+{
+    detach();
+}
+
+NAMESPACE_CORE_OS_END
@@ -0,0 +1,84 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/os/namespace.hpp>
+#include <core/common.hpp>
+#include <ch.h>
+
+NAMESPACE_CORE_OS_BEGIN
+
+
+class EventSource_:
+    private core::Uncopyable
+{
+public:
+    typedef ::eventflags_t Flags;
+
+private:
+    ::event_source_t impl;
+
+public:
+    void
+    initialize();
+
+    void
+    broadcast_unsafe(
+        Flags flags
+    );
+
+    void
+    broadcast(
+        Flags flags
+    );
+
+
+    ::event_source_t & get_impl();
+
+public:
+    EventSource_();
+};
+
+
+inline
+void
+EventSource_::initialize()
+{
+    chEvtObjectInit(&impl);
+}
+
+inline
+void
+EventSource_::broadcast_unsafe(
+    Flags flags
+)
+{
+    chEvtBroadcastFlagsI(&impl, flags);
+}
+
+inline
+void
+EventSource_::broadcast(
+    Flags flags
+)
+{
+    chEvtBroadcastFlags(&impl, flags);
+}
+
+inline
+  ::event_source_t& EventSource_::get_impl() {
+    return impl;
+}
+
+
+inline
+EventSource_::EventSource_()
+{
+    initialize();
+}
+
+NAMESPACE_CORE_OS_END
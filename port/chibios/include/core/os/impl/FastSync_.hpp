@@ -0,0 +1,25 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <ch.h>
+
+/*! \brief Enables the LDREX/STREX fast paths of Mutex_ and Semaphore_
+ *
+ * Uncontended operations complete with an exclusive access on the object, without entering the kernel.
+ * The kernel is still used on contention, so priority inheritance and waiter queues are unchanged.
+ * Only effective on ARMv7-M cores and with non recursive mutexes.
+ */
+#ifndef CORE_USE_FAST_SYNC
+#define CORE_USE_FAST_SYNC true
+#endif
+
+#if CORE_USE_FAST_SYNC && (defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__))
+#define CORE_FAST_SYNC_ true
+#else
+#define CORE_FAST_SYNC_ false
+#endif
@@ -0,0 +1,305 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/os/namespace.hpp>
+#include <core/common.hpp>
+#include <core/os/Time.hpp>
+#include <ch.h>
+
+NAMESPACE_CORE_OS_BEGIN
+
+
+class Mailbox_:
+    private core::Uncopyable
+{
+public:
+    typedef ::msg_t Message;
+
+private:
+    ::mailbox_t impl;
+    size_t      watermark;
+
+public:
+    bool
+    post_unsafe(
+        Message msg
+    );
+
+    bool
+    post_ahead_unsafe(
+        Message msg
+    );
+
+    bool
+    fetch_unsafe(
+        Message& msg
+    );
+
+    size_t
+    get_used_unsafe();
+
+    size_t
+    get_free_unsafe();
+
+    bool
+    post(
+        Message     msg,
+        const Time& timeout
+    );
+
+    bool
+    post_ahead(
+        Message     msg,
+        const Time& timeout
+    );
+
+    bool
+    fetch(
+        Message&    msg,
+        const Time& timeout
+    );
+
+    size_t
+    get_used();
+
+    size_t
+    get_free();
+
+    size_t
+    get_watermark() const;
+
+    void
+    reset_watermark();
+
+    void
+    reset();
+
+
+    ::mailbox_t & get_impl();
+
+public:
+    Mailbox_(
+        Message* buffer,
+        size_t   size
+    );
+
+private:
+    bool
+    post(
+        Message     msg,
+        bool        ahead,
+        const Time& timeout
+    );
+
+    void
+    update_watermark();
+};
+
+
+inline
+bool
+Mailbox_::post_unsafe(
+    Message msg
+)
+{
+    if (chMBPostI(&impl, msg) != MSG_OK) {
+        return false;
+    }
+
+    update_watermark();
+    return true;
+}
+
+inline
+bool
+Mailbox_::post_ahead_unsafe(
+    Message msg
+)
+{
+    if (chMBPostAheadI(&impl, msg) != MSG_OK) {
+        return false;
+    }
+
+    update_watermark();
+    return true;
+}
+
+inline
+bool
+Mailbox_::fetch_unsafe(
+    Message& msg
+)
+{
+    return chMBFetchI(&impl, &msg) == MSG_OK;
+}
+
+inline
+size_t
+Mailbox_::get_used_unsafe()
+{
+    return static_cast<size_t>(chMBGetUsedCountI(&impl));
+}
+
+inline
+size_t
+Mailbox_::get_free_unsafe()
+{
+    return static_cast<size_t>(chMBGetFreeCountI(&impl));
+}
+
+inline
+bool
+Mailbox_::post(
+    Message     msg,
+    const Time& timeout
+)
+{
+    return post(msg, false, timeout);
+}
+
+inline
+bool
+Mailbox_::post_ahead(
+    Message     msg,
+    const Time& timeout
+)
+{
+    return post(msg, true, timeout);
+}
+
+inline
+bool
+Mailbox_::fetch(
+    Message&    msg,
+    const Time& timeout
+)
+{
+    return chMBFetch(&impl, &msg, timeout.ticks()) == MSG_OK;
+}
+
+inline
+size_t
+Mailbox_::get_used()
+{
+    size_t used;
+
+    chSysLock();
+    used = get_used_unsafe();
+    chSysUnlock();
+
+    return used;
+}
+
+inline
+size_t
+Mailbox_::get_free()
+{
+    size_t free;
+
+    chSysLock();
+    free = get_free_unsafe();
+    chSysUnlock();
+
+    return free;
+}
+
+inline
+size_t
+Mailbox_::get_watermark() const
+{
+    return watermark;
+}
+
+inline
+void
+Mailbox_::reset_watermark()
+{
+    chSysLock();
+    watermark = 0;
+    update_watermark();
+    chSysUnlock();
+}
+
+inline
+void
+Mailbox_::reset()
+{
+    chMBReset(&impl);
+}
+
+inline
+  ::mailbox_t& Mailbox_::get_impl() {
+    return impl;
+}
+
+inline
+bool
+Mailbox_::post(
+    Message     msg,
+    bool        ahead,
+    const Time& timeout
+)
+{
+    msg_t result;
+
+    // Same as chMBPostS and chMBPostAheadS, but the watermark is sampled before rescheduling,
+    // or a higher priority fetcher would drain the message first. The free slot is already taken, so no chMBPostI.
+    chSysLock();
+    result = chSemWaitTimeoutS(&impl.mb_emptysem, timeout.ticks());
+
+    if (result == MSG_OK) {
+        if (ahead) {
+            if (--impl.mb_rdptr < impl.mb_buffer) {
+                impl.mb_rdptr = impl.mb_top - 1;
+            }
+
+            *impl.mb_rdptr = msg;
+        } else {
+            *impl.mb_wrptr++ = msg;
+
+            if (impl.mb_wrptr >= impl.mb_top) {
+                impl.mb_wrptr = impl.mb_buffer;
+            }
+        }
+
+        chSemSignalI(&impl.mb_fullsem);
+        update_watermark();
+        chSchRescheduleS();
+    }
+
+    chSysUnlock();
+
+    return result == MSG_OK;
+} // post
+
+inline
+void
+Mailbox_::update_watermark()
+{
+    // Slots not free are holding a message, including those already handed over to a woken up fetcher:
+    // unlike get_used_unsafe, this does not drop when a posted message wakes up a fetcher that did not run yet.
+    ::cnt_t free = chSemGetCounterI(&impl.mb_emptysem);
+    size_t  used = static_cast<size_t>(impl.mb_top - impl.mb_buffer) - static_cast<size_t>((free > 0) ? free : 0);
+
+    if (used > watermark) {
+        watermark = used;
+    }
+}
+
+inline
+Mailbox_::Mailbox_(
+    Message* buffer,
+    size_t   size
+)
+    :
+    watermark(0)
+{
+    chMBObjectInit(&impl, buffer, static_cast<cnt_t>(size));
+}
+
+NAMESPACE_CORE_OS_END
@@ -8,8 +8,12 @@
 
 #include <core/os/namespace.hpp>
 #include <core/common.hpp>
+#include <core/os/impl/FastSync_.hpp>
 #include <ch.h>
 
+// Recursive mutexes keep a lock count the fast path does not handle.
+#define CORE_FAST_SYNC_MUTEX_ (CORE_FAST_SYNC_ && !CH_CFG_USE_MUTEXES_RECURSIVE)
+
 NAMESPACE_CORE_OS_BEGIN
 
 class Mutex_:
@@ -28,9 +32,15 @@ public:
     void
     release_unsafe();
 
+    bool
+    try_acquire_unsafe();
+
     void
     acquire();
 
+    bool
+    try_acquire();
+
     void
     release();
 
@@ -43,6 +53,15 @@ public:
     Mutex_(
         bool initialize
     );
+
+#if CORE_FAST_SYNC_MUTEX_
+private:
+    bool
+    fast_acquire();
+
+    bool
+    fast_release();
+#endif
 };
 
 
@@ -67,17 +86,46 @@ Mutex_::release_unsafe()
     chMtxUnlockS(&impl);
 }
 
+inline
+bool
+Mutex_::try_acquire_unsafe()
+{
+    return chMtxTryLockS(&impl);
+}
+
 inline
 void
 Mutex_::acquire()
 {
+#if CORE_FAST_SYNC_MUTEX_
+    if (fast_acquire()) {
+        return;
+    }
+#endif
     chMtxLock(&impl);
 }
 
+inline
+bool
+Mutex_::try_acquire()
+{
+#if CORE_FAST_SYNC_MUTEX_
+    return fast_acquire();
+
+#else
+    return chMtxTryLock(&impl);
+#endif
+}
+
 inline
 void
 Mutex_::release()
 {
+#if CORE_FAST_SYNC_MUTEX_
+    if (fast_release()) {
+        return;
+    }
+#endif
     chMtxUnlock(&impl);
 }
 
@@ -103,4 +151,63 @@ Mutex_::Mutex_(
     }
 }
 
+#if CORE_FAST_SYNC_MUTEX_
+inline
+bool
+Mutex_::fast_acquire()
+{
+    static_assert(sizeof(::thread_t*) == sizeof(uint32_t), "Pointers must be 32 bit wide");
+
+    volatile uint32_t* owner = reinterpret_cast<volatile uint32_t*>(&impl.m_owner);
+    ::thread_t*        self  = chThdGetSelfX();
+
+    do {
+        if (__LDREXW(owner) != 0) {
+            __CLREX();
+            return false;
+        }
+    } while (__STREXW(reinterpret_cast<uint32_t>(self), owner) != 0);
+
+    __DMB();
+
+    // Same bookkeeping as chMtxLockS. If a contender preempts us before this, it only queues up and
+    // boosts our priority: the release will then take the kernel path.
+    impl.m_next     = self->p_mtxlist;
+    self->p_mtxlist = &impl;
+
+    return true;
+} // fast_acquire
+
+inline
+bool
+Mutex_::fast_release()
+{
+    volatile uint32_t* owner = reinterpret_cast<volatile uint32_t*>(&impl.m_owner);
+    ::thread_t*        self  = chThdGetSelfX();
+    ::mutex_t*         next  = impl.m_next; // Must be read while still owning the mutex.
+
+    CORE_ASSERT(self->p_mtxlist == &impl);
+
+    __DMB();
+
+    // Any preemption between LDREX and STREX clears the exclusive monitor, so the queue check is atomic
+    // with the release: a waiter enqueued meanwhile makes the STREX fail.
+    do {
+        uint32_t value = __LDREXW(owner);
+
+        CORE_ASSERT(value == reinterpret_cast<uint32_t>(self));
+        (void)value;
+
+        if (queue_notempty(&impl.m_queue)) {
+            __CLREX();
+            return false;
+        }
+    } while (__STREXW(0, owner) != 0);
+
+    self->p_mtxlist = next;
+
+    return true;
+} // fast_release
+#endif // if CORE_FAST_SYNC_MUTEX_
+
 NAMESPACE_CORE_OS_END
@@ -17,6 +17,9 @@ NAMESPACE_CORE_OS_BEGIN
 class OS_:
     private core::Uncopyable
 {
+public:
+    typedef uint32_t RealtimeCounter;
+
 public:
     static void
     initialize();
@@ -32,6 +35,9 @@ public:
     static void
     disable();
 
+    static RealtimeCounter
+    get_realtime_counter();
+
 
 private:
     OS_();
@@ -66,4 +72,15 @@ OS_::disable()
     osalSysDisable();
 }
 
+inline OS_::RealtimeCounter
+OS_::get_realtime_counter()
+{
+#if PORT_SUPPORTS_RT
+    return chSysGetRealtimeCounterX();
+
+#else
+    return chVTGetSystemTimeX();
+#endif
+}
+
 NAMESPACE_CORE_OS_END
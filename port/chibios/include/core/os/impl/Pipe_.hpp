@@ -0,0 +1,287 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/os/namespace.hpp>
+#include <core/common.hpp>
+#include <core/os/Time.hpp>
+#include <core/os/impl/Mutex_.hpp>
+#include <ch.h>
+
+#include <cstring>
+
+NAMESPACE_CORE_OS_BEGIN
+
+
+class Pipe_:
+    private core::Uncopyable
+{
+private:
+    uint8_t* buffer;
+    size_t   size;
+    size_t   rdoff;
+    size_t   wroff;
+    size_t   count;
+    bool     direct;
+
+    Mutex_ rmtx;
+    Mutex_ wmtx;
+    ::thread_reference_t rwait;
+    ::thread_reference_t wwait;
+
+    // Destination of the blocked reader, filled directly by the writer when the buffer is empty.
+    uint8_t* rdirect;
+    size_t   rdirect_left;
+    size_t   rdirect_done;
+    unsigned rclaims;
+
+public:
+    size_t
+    get_size() const;
+
+    size_t
+    get_count() const;
+
+    size_t
+    write(
+        const uint8_t* datap,
+        size_t         length,
+        const Time&    timeout
+    );
+
+    size_t
+    read(
+        uint8_t*    datap,
+        size_t      length,
+        const Time& timeout
+    );
+
+
+public:
+    Pipe_(
+        uint8_t* buffer,
+        size_t   size,
+        bool     direct
+    );
+
+private:
+    static systime_t
+    remaining(
+        systime_t   start,
+        const Time& timeout
+    );
+};
+
+
+inline
+size_t
+Pipe_::get_size() const
+{
+    return size;
+}
+
+inline
+size_t
+Pipe_::get_count() const
+{
+    return count;
+}
+
+inline
+size_t
+Pipe_::write(
+    const uint8_t* datap,
+    size_t         length,
+    const Time&    timeout
+)
+{
+    systime_t start;
+    size_t    done = 0;
+
+    wmtx.acquire();
+    // Sampled once the mutex is held, the timeout does not include the wait for the other writers.
+    start = chVTGetSystemTimeX();
+    chSysLock();
+
+    while (done < length) {
+        if ((rdirect_left > 0) && (count == 0)) {
+            // The reader is blocked on an empty pipe: copy straight into its buffer.
+            // The claim keeps the reader from returning, even on timeout, while its buffer is being written.
+            size_t   chunk  = (length - done < rdirect_left) ? (length - done) : rdirect_left;
+            uint8_t* target = rdirect;
+
+            rdirect      += chunk;
+            rdirect_left -= chunk;
+            rclaims++;
+
+            chSysUnlock();
+            memcpy(target, datap + done, chunk);
+            chSysLock();
+
+            rclaims--;
+            rdirect_done += chunk;
+            done         += chunk;
+            chThdResumeS(&rwait, MSG_OK);
+            continue;
+        }
+
+        if (count < size) {
+            // Only the reader touches the filled part, so the free part can be copied outside the lock.
+            size_t contiguous = (wroff >= rdoff) ? (size - wroff) : (rdoff - wroff);
+            size_t chunk      = size - count;
+
+            chunk = (chunk < contiguous) ? chunk : contiguous;
+            chunk = (chunk < length - done) ? chunk : (length - done);
+
+            uint8_t* target = buffer + wroff;
+
+            chSysUnlock();
+            memcpy(target, datap + done, chunk);
+            chSysLock();
+
+            wroff  = (wroff + chunk) % size;
+            count += chunk;
+            done  += chunk;
+            chThdResumeS(&rwait, MSG_OK);
+            continue;
+        }
+
+        systime_t ticks = remaining(start, timeout);
+
+        if ((ticks == TIME_IMMEDIATE) || (chThdSuspendTimeoutS(&wwait, ticks) == MSG_TIMEOUT)) {
+            if (count == size) {
+                break;
+            }
+        }
+    }
+
+    chSchRescheduleS();
+    chSysUnlock();
+    wmtx.release();
+
+    return done;
+} // write
+
+inline
+size_t
+Pipe_::read(
+    uint8_t*    datap,
+    size_t      length,
+    const Time& timeout
+)
+{
+    systime_t start;
+    size_t    done = 0;
+
+    rmtx.acquire();
+    // Sampled once the mutex is held, the timeout does not include the wait for the other readers.
+    start = chVTGetSystemTimeX();
+    chSysLock();
+
+    while (done < length) {
+        if (count > 0) {
+            size_t contiguous = size - rdoff;
+            size_t chunk      = (count < contiguous) ? count : contiguous;
+
+            chunk = (chunk < length - done) ? chunk : (length - done);
+
+            const uint8_t* source = buffer + rdoff;
+
+            chSysUnlock();
+            memcpy(datap + done, source, chunk);
+            chSysLock();
+
+            rdoff  = (rdoff + chunk) % size;
+            count -= chunk;
+            done  += chunk;
+            chThdResumeS(&wwait, MSG_OK);
+            continue;
+        }
+
+        systime_t ticks = remaining(start, timeout);
+
+        if (ticks == TIME_IMMEDIATE) {
+            break;
+        }
+
+        if (direct) {
+            rdirect      = datap + done;
+            rdirect_left = length - done;
+            rdirect_done = 0;
+        }
+
+        msg_t msg = chThdSuspendTimeoutS(&rwait, ticks);
+
+        if (direct) {
+            // No new claims, then wait for the copy in progress, if any.
+            rdirect_left = 0;
+
+            while (rclaims > 0) {
+                chThdSuspendS(&rwait);
+            }
+
+            done        += rdirect_done;
+            rdirect_done = 0;
+            rdirect      = NULL;
+        }
+
+        if ((msg == MSG_TIMEOUT) && (count == 0)) {
+            break;
+        }
+    }
+
+    chSchRescheduleS();
+    chSysUnlock();
+    rmtx.release();
+
+    return done;
+} // read
+
+inline
+systime_t
+Pipe_::remaining(
+    systime_t   start,
+    const Time& timeout
+)
+{
+    systime_t ticks = timeout.ticks();
+
+    if ((ticks == TIME_INFINITE) || (ticks == TIME_IMMEDIATE)) {
+        return ticks;
+    }
+
+    systime_t elapsed = chVTTimeElapsedSinceX(start);
+
+    return (elapsed < ticks) ? (ticks - elapsed) : TIME_IMMEDIATE;
+}
+
+inline
+Pipe_::Pipe_(
+    uint8_t* buffer,
+    size_t   size,
+    bool     direct
+)
+    :
+    buffer(buffer),
+    size(size),
+    rdoff(0),
+    wroff(0),
+    count(0),
+    direct(direct),
+    rmtx(),
+    wmtx(),
+    rwait(NULL),
+    wwait(NULL),
+    rdirect(NULL),
+    rdirect_left(0),
+    rdirect_done(0),
+    rclaims(0)
+{
+    CORE_ASSERT(size > 0);
+}
+
+NAMESPACE_CORE_OS_END
@@ -9,6 +9,7 @@
 #include <core/os/namespace.hpp>
 #include <core/common.hpp>
 #include <core/os/Time.hpp>
+#include <core/os/impl/FastSync_.hpp>
 #include <ch.h>
 
 NAMESPACE_CORE_OS_BEGIN
@@ -45,6 +46,22 @@ public:
         const Time& timeout
     );
 
+    void
+    signal_n_unsafe(
+        Count count
+    );
+
+    void
+    wait_n_unsafe(
+        Count count
+    );
+
+    bool
+    wait_n_unsafe(
+        Count       count,
+        const Time& timeout
+    );
+
     void
     reset(
         Count value = 0
@@ -61,6 +78,22 @@ public:
         const Time& timeout
     );
 
+    void
+    signal_n(
+        Count count
+    );
+
+    void
+    wait_n(
+        Count count
+    );
+
+    bool
+    wait_n(
+        Count       count,
+        const Time& timeout
+    );
+
 
     ::semaphore_t & get_impl();
 
@@ -73,6 +106,15 @@ public:
         bool  initialize,
         Count value = 0
     );
+
+#if CORE_FAST_SYNC_
+private:
+    bool
+    fast_signal();
+
+    bool
+    fast_wait();
+#endif
 };
 
 
@@ -117,6 +159,82 @@ Semaphore_::wait_unsafe(
     return chSemWaitTimeoutS(&impl, timeout.ticks()) == MSG_OK;
 }
 
+inline
+void
+Semaphore_::signal_n_unsafe(
+    Count count
+)
+{
+    CORE_ASSERT(count > 0);
+
+    chSemAddCounterI(&impl, count);
+}
+
+inline
+void
+Semaphore_::wait_n_unsafe(
+    Count count
+)
+{
+    CORE_ASSERT(count > 0);
+
+    if (chSemGetCounterI(&impl) >= count) {
+        while (count-- > 0) {
+            chSemFastWaitI(&impl);
+        }
+    } else {
+        while (count-- > 0) {
+            chSemWaitS(&impl);
+        }
+    }
+}
+
+inline
+bool
+Semaphore_::wait_n_unsafe(
+    Count       count,
+    const Time& timeout
+)
+{
+    CORE_ASSERT(count > 0);
+
+    if (chSemGetCounterI(&impl) >= count) {
+        while (count-- > 0) {
+            chSemFastWaitI(&impl);
+        }
+
+        return true;
+    }
+
+    if (timeout.ticks() == TIME_IMMEDIATE) {
+        return false;
+    }
+
+    systime_t start = chVTGetSystemTimeX();
+
+    for (Count taken = 0; taken < count; taken++) {
+        systime_t remaining = timeout.ticks();
+
+        if (remaining != TIME_INFINITE) {
+            systime_t elapsed = chVTTimeElapsedSinceX(start);
+
+            remaining = (elapsed < remaining) ? (remaining - elapsed) : TIME_IMMEDIATE;
+        }
+
+        if ((remaining == TIME_IMMEDIATE) || (chSemWaitTimeoutS(&impl, remaining) != MSG_OK)) {
+            // All or nothing: give back what was taken, it may wake up other waiters.
+            if (taken > 0) {
+                chSemAddCounterI(&impl, taken);
+                chSchRescheduleS();
+            }
+
+            return false;
+        }
+    }
+
+    return true;
+} // wait_n_unsafe
+
 inline
 void
 Semaphore_::reset(
@@ -130,6 +248,11 @@ inline
 void
 Semaphore_::signal()
 {
+#if CORE_FAST_SYNC_
+    if (fast_signal()) {
+        return;
+    }
+#endif
     chSemSignal(&impl);
 }
 
@@ -137,6 +260,11 @@ inline
 void
 Semaphore_::wait()
 {
+#if CORE_FAST_SYNC_
+    if (fast_wait()) {
+        return;
+    }
+#endif
     chSemWait(&impl);
 }
 
@@ -146,9 +274,53 @@ Semaphore_::wait(
     const Time& timeout
 )
 {
+#if CORE_FAST_SYNC_
+    if (fast_wait()) {
+        return true;
+    }
+#endif
     return chSemWaitTimeout(&impl, timeout.ticks()) == MSG_OK;
 }
 
+inline
+void
+Semaphore_::signal_n(
+    Count count
+)
+{
+    chSysLock();
+    signal_n_unsafe(count);
+    chSchRescheduleS();
+    chSysUnlock();
+}
+
+inline
+void
+Semaphore_::wait_n(
+    Count count
+)
+{
+    chSysLock();
+    wait_n_unsafe(count);
+    chSysUnlock();
+}
+
+inline
+bool
+Semaphore_::wait_n(
+    Count       count,
+    const Time& timeout
+)
+{
+    bool success;
+
+    chSysLock();
+    success = wait_n_unsafe(count, timeout);
+    chSysUnlock();
+
+    return success;
+}
+
 inline
   ::semaphore_t& Semaphore_::get_impl() {
     return impl;
@@ -174,4 +346,51 @@ Semaphore_::Semaphore_(
     }
 }
 
+#if CORE_FAST_SYNC_
+inline
+bool
+Semaphore_::fast_signal()
+{
+    static_assert(sizeof(Count) == sizeof(uint32_t), "Counter must be 32 bit wide");
+
+    volatile uint32_t* counter = reinterpret_cast<volatile uint32_t*>(&impl.s_cnt);
+    Count value;
+
+    __DMB();
+
+    // A negative counter means there are waiters to wake up, which only the kernel can do.
+    do {
+        value = static_cast<Count>(__LDREXW(counter));
+
+        if (value < 0) {
+            __CLREX();
+            return false;
+        }
+    } while (__STREXW(static_cast<uint32_t>(value + 1), counter) != 0);
+
+    return true;
+}
+
+inline
+bool
+Semaphore_::fast_wait()
+{
+    volatile uint32_t* counter = reinterpret_cast<volatile uint32_t*>(&impl.s_cnt);
+    Count value;
+
+    do {
+        value = static_cast<Count>(__LDREXW(counter));
+
+        if (value <= 0) {
+            __CLREX();
+            return false;
+        }
+    } while (__STREXW(static_cast<uint32_t>(value - 1), counter) != 0);
+
+    __DMB();
+
+    return true;
+}
+#endif // if CORE_FAST_SYNC_
+
 NAMESPACE_CORE_OS_END
@@ -12,6 +12,14 @@
 #include <core/os/Thread.hpp>
 #include <ch.h>
 
+#ifndef CORE_SPIN_EVENT_SPIN_CYCLES
+#define CORE_SPIN_EVENT_SPIN_CYCLES 0
+#endif
+
+#ifndef CORE_SPIN_EVENT_STATS
+#define CORE_SPIN_EVENT_STATS false
+#endif
+
 NAMESPACE_CORE_OS_BEGIN
 
 
@@ -19,12 +27,18 @@ class SpinEvent_
 {
 public:
     typedef ::eventmask_t Mask;
+    typedef uint32_t      Cycles;
 
 private:
     typedef ::thread_t ChThread;
 
 private:
     Thread* threadp;
+    Cycles  spin_cycles;
+#if CORE_SPIN_EVENT_STATS
+    uint32_t spin_hits;
+    uint32_t spin_misses;
+#endif
 
 public:
     Thread*
@@ -51,6 +65,25 @@ public:
         const Time& timeout
     );
 
+    Cycles
+    get_spin() const;
+
+    void
+    set_spin(
+        Cycles cycles
+    );
+
+#if CORE_SPIN_EVENT_STATS
+    uint32_t
+    get_spin_hits() const;
+
+    uint32_t
+    get_spin_misses() const;
+
+    void
+    reset_spin_stats();
+#endif
+
 
 public:
     SpinEvent_(
@@ -115,15 +148,88 @@ SpinEvent_::wait(
 
     ticks = timeout.ticks();
 
+#if PORT_SUPPORTS_RT
+    if ((spin_cycles > 0) && (ticks != TIME_IMMEDIATE)) {
+        // Poll the pending events for a while, a signal from an ISR may arrive before a context switch would complete.
+        const volatile Mask* pendingp = &chThdGetSelfX()->p_epending;
+        systime_t            entered  = chVTGetSystemTimeX();
+        rtcnt_t              start    = chSysGetRealtimeCounterX();
+
+        do {
+            if (*pendingp != 0) {
+#if CORE_SPIN_EVENT_STATS
+                spin_hits++;
+#endif
+                return chEvtGetAndClearEvents(ALL_EVENTS);
+            }
+        } while ((chSysGetRealtimeCounterX() - start) < spin_cycles);
+
+#if CORE_SPIN_EVENT_STATS
+        spin_misses++;
+#endif
+
+        // The spin counts against the timeout, block only for what is left (a last check if nothing is).
+        if (ticks != TIME_INFINITE) {
+            systime_t elapsed = chVTTimeElapsedSinceX(entered);
+
+            ticks = (elapsed < ticks) ? (ticks - elapsed) : TIME_IMMEDIATE;
+        }
+    }
+#endif // if PORT_SUPPORTS_RT
+
     return chEvtWaitAnyTimeout(ALL_EVENTS, ticks);
+} // wait
+
+inline
+SpinEvent_::Cycles
+SpinEvent_::get_spin() const
+{
+    return spin_cycles;
+}
+
+inline
+void
+SpinEvent_::set_spin(
+    Cycles cycles
+)
+{
+    spin_cycles = cycles;
+}
+
+#if CORE_SPIN_EVENT_STATS
+inline
+uint32_t
+SpinEvent_::get_spin_hits() const
+{
+    return spin_hits;
+}
+
+inline
+uint32_t
+SpinEvent_::get_spin_misses() const
+{
+    return spin_misses;
 }
 
+inline
+void
+SpinEvent_::reset_spin_stats()
+{
+    spin_hits   = 0;
+    spin_misses = 0;
+}
+#endif // if CORE_SPIN_EVENT_STATS
+
 inline
 SpinEvent_::SpinEvent_(
     Thread* threadp
 )
     :
-    threadp(threadp)
+    threadp(threadp),
+    spin_cycles(CORE_SPIN_EVENT_SPIN_CYCLES)
+#if CORE_SPIN_EVENT_STATS
+    , spin_hits(0), spin_misses(0)
+#endif
 {}
 
 
@@ -16,6 +16,9 @@ NAMESPACE_CORE_OS_BEGIN
 class SysLock_:
     private core::Uncopyable
 {
+public:
+    typedef ::syssts_t Status;
+
 private:
     SysLock_();
 
@@ -31,6 +34,14 @@ public:
 
     static void
     release_from_isr();
+
+    static Status
+    get_status_and_acquire();
+
+    static void
+    restore_status(
+        Status status
+    );
 };
 
 
@@ -63,4 +74,20 @@ SysLock_::release_from_isr()
     osalSysUnlockFromISR();
 }
 
+inline
+SysLock_::Status
+SysLock_::get_status_and_acquire()
+{
+    return osalSysGetStatusAndLockX();
+}
+
+inline
+void
+SysLock_::restore_status(
+    Status status
+)
+{
+    osalSysRestoreStatusX(status);
+}
+
 NAMESPACE_CORE_OS_END
@@ -0,0 +1,171 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#include <core/os/SysLock.hpp>
+
+#if CORE_SYSLOCK_STATS
+
+NAMESPACE_CORE_OS_BEGIN
+
+// Out of line, so that __builtin_return_address identifies the code that took the lock.
+
+void
+SysLock::acquire()
+{
+    SysLock_::acquire();
+    stats_acquired(state().raw, __builtin_return_address(0));
+}
+
+void
+SysLock::release()
+{
+    Hold hold = state().raw;
+
+    stats_released(hold);
+    SysLock_::release();
+}
+
+void
+SysLock::acquire_from_isr()
+{
+    SysLock_::acquire_from_isr();
+    stats_acquired(state().raw, __builtin_return_address(0));
+}
+
+void
+SysLock::release_from_isr()
+{
+    Hold hold = state().raw;
+
+    stats_released(hold);
+    SysLock_::release_from_isr();
+}
+
+void
+SysLock::acquire(
+    Hold& hold
+)
+{
+    SysLock_::acquire();
+    stats_acquired(hold, __builtin_return_address(0));
+}
+
+void
+SysLock::release(
+    const Hold& hold
+)
+{
+    stats_released(hold);
+    SysLock_::release();
+}
+
+void
+SysLock::acquire_from_isr(
+    Hold& hold
+)
+{
+    SysLock_::acquire_from_isr();
+    stats_acquired(hold, __builtin_return_address(0));
+}
+
+void
+SysLock::release_from_isr(
+    const Hold& hold
+)
+{
+    stats_released(hold);
+    SysLock_::release_from_isr();
+}
+
+void
+SysLock::get_stats(
+    Stats& stats
+)
+{
+    // Not through SysLock::acquire, the copy itself must not show up in the statistics.
+    SysLock_::acquire();
+    stats = state().stats;
+    SysLock_::release();
+}
+
+void
+SysLock::reset_stats()
+{
+    SysLock_::acquire();
+    state().stats = Stats();
+    SysLock_::release();
+}
+
+void
+SysLock::stats_context_switch()
+{
+    state().sequence++;
+}
+
+SysLock::State&
+SysLock::state()
+{
+    static State state;
+
+    return state;
+}
+
+void
+SysLock::stats_acquired(
+    Hold&       hold,
+    const void* address
+)
+{
+    State& current = state();
+
+    hold.address  = address;
+    hold.sequence = ++current.sequence;
+    hold.start    = OS::get_realtime_counter();
+}
+
+void
+SysLock::stats_released(
+    const Hold& hold
+)
+{
+    State& current  = state();
+    Cycles duration = OS::get_realtime_counter() - hold.start;
+    Stats& stats    = current.stats;
+
+    // Anything else happening since the acquire means the thread blocked, and the lock was not held all along.
+    if (hold.sequence != current.sequence++) {
+        stats.blocked++;
+        return;
+    }
+
+    stats.count++;
+    stats.total += duration;
+
+    if (duration > stats.max) {
+        stats.max         = duration;
+        stats.max_address = hold.address;
+    }
+
+    for (Site& site : stats.sites) {
+        if ((site.address == hold.address) || (site.address == nullptr)) {
+            site.address = hold.address;
+            site.count++;
+            site.total += duration;
+
+            if (duration > site.max) {
+                site.max = duration;
+            }
+
+            return;
+        }
+    }
+
+    stats.untracked++;
+} // stats_released
+
+NAMESPACE_CORE_OS_END
+
+#endif // if CORE_SYSLOCK_STATS